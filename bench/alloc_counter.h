@@ -0,0 +1,15 @@
+#ifndef C1F2D8B6_5A0E_4C5B_9E5F_3B1C7A2D9E41
+#define C1F2D8B6_5A0E_4C5B_9E5F_3B1C7A2D9E41
+
+#include <cstdint>
+
+namespace wwa::opentelemetry::bench {
+
+/**
+ * Returns the number of calls to the global `operator new` made by the current thread so far.
+ */
+std::uint64_t allocation_count() noexcept;
+
+}  // namespace wwa::opentelemetry::bench
+
+#endif /* C1F2D8B6_5A0E_4C5B_9E5F_3B1C7A2D9E41 */
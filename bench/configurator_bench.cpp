@@ -0,0 +1,123 @@
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include <opentelemetry/sdk/resource/resource.h>
+
+#include "fixtures.h"
+#include "opentelemetry/configurator/wwa/configurator.h"
+
+namespace {
+
+using namespace wwa::opentelemetry;
+
+resource_config_t get_bench_resource_config()
+{
+    resource_config_t config;
+    config.service_name = "bench";
+    return config;
+}
+
+const ::opentelemetry::sdk::resource::Resource& get_bench_resource()
+{
+    static const auto resource = configure_resource(get_bench_resource_config());
+    return resource;
+}
+
+/**
+ * Runs `configure` once per iteration; the object it returns is destroyed (and thus shut down) outside the timed region.
+ */
+template<typename F>
+void measure_cold_start(benchmark::State& state, F&& configure)
+{
+    for (auto _ : state) {
+        auto result = configure();
+        state.PauseTiming();
+        result.reset();
+        state.ResumeTiming();
+    }
+}
+
+void BM_configure_resource(benchmark::State& state)
+{
+    const auto config = get_bench_resource_config();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(configure_resource(config));
+    }
+}
+
+void BM_configure_propagators_from_environment(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(configure_propagators_from_environment({}, bench::stub_environment()));
+    }
+}
+
+void BM_configure_tracing_sampler_from_environment(benchmark::State& state)
+{
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(configure_tracing_sampler_from_environment({}, bench::stub_environment()));
+    }
+}
+
+void BM_configure_tracer_provider(benchmark::State& state)
+{
+    measure_cold_start(state, []() {
+        tracer_provider_config_t config;
+        config.span_exporter_config.factory = bench::stub_span_exporter_factory;
+        config.resource                     = get_bench_resource();
+        return configure_tracer_provider(std::move(config), bench::stub_environment());
+    });
+}
+
+void BM_configure_meter_provider(benchmark::State& state)
+{
+    measure_cold_start(state, []() {
+        meter_provider_config_t config;
+        config.metric_exporter_config.factory = bench::stub_metric_exporter_factory;
+        config.resource                       = get_bench_resource();
+        return configure_meter_provider(std::move(config), bench::stub_environment());
+    });
+}
+
+void BM_configure_logger_provider(benchmark::State& state)
+{
+    measure_cold_start(state, []() {
+        logger_provider_config_t config;
+        config.log_record_exporter_config.factory = bench::stub_log_record_exporter_factory;
+        config.resource                           = get_bench_resource();
+        return configure_logger_provider(std::move(config), bench::stub_environment());
+    });
+}
+
+void BM_configure_opentelemetry(benchmark::State& state, bool concurrent)
+{
+    for (auto _ : state) {
+        // Replacing the global providers shuts the previous ones down; keep that out of the timed region
+        state.PauseTiming();
+        bench::install_noop_providers();
+        state.ResumeTiming();
+
+        opentelemetry_configuration_t config;
+        config.resource                           = get_bench_resource();
+        config.concurrent_initialization          = concurrent;
+        config.span_exporter_config.factory       = bench::stub_span_exporter_factory;
+        config.metric_exporter_config.factory     = bench::stub_metric_exporter_factory;
+        config.log_record_exporter_config.factory = bench::stub_log_record_exporter_factory;
+        configure_opentelemetry(std::move(config), bench::stub_environment());
+    }
+
+    bench::install_noop_providers();
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
+BENCHMARK(BM_configure_resource);
+BENCHMARK(BM_configure_propagators_from_environment);
+BENCHMARK(BM_configure_tracing_sampler_from_environment);
+BENCHMARK(BM_configure_tracer_provider)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_configure_meter_provider)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_configure_logger_provider)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_configure_opentelemetry, sequential, false)->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_configure_opentelemetry, concurrent, true)->Unit(benchmark::kMicrosecond);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
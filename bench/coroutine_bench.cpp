@@ -0,0 +1,144 @@
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include <opentelemetry/context/context.h>
+#include <opentelemetry/context/runtime_context.h>
+#include <opentelemetry/nostd/shared_ptr.h>
+#include <opentelemetry/trace/context.h>
+#include <opentelemetry/trace/span_startoptions.h>
+#include <opentelemetry/trace/tracer.h>
+
+#include "alloc_counter.h"
+#include "fixtures.h"
+#include "opentelemetry/configurator/wwa/coroutine.h"
+#include "opentelemetry/configurator/wwa/utils.h"
+
+namespace {
+
+using tracer_t = opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer>;
+
+/**
+ * Minimal lazily started task: the awaiting coroutine is resumed by symmetric transfer, and the frame is destroyed
+ * with the task object, i.e., after the awaiting coroutine has resumed. This is the order in which the usual task
+ * types destroy their frames, and the one in which a coroutine that detaches too late breaks its caller's context.
+ */
+class task {
+public:
+    struct promise_type {
+        bool value = false;
+        std::coroutine_handle<> continuation;
+
+        task get_return_object() { return task(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        auto final_suspend() noexcept
+        {
+            struct final_awaiter {
+                bool await_ready() noexcept { return false; }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    return handle.promise().continuation;
+                }
+
+                void await_resume() noexcept {}
+            };
+
+            return final_awaiter{};
+        }
+
+        void return_value(bool v) { this->value = v; }
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    // Movable, so that coroutine_context::wrap() can keep the task alive until the awaiting coroutine resumes
+    task(task&& other) noexcept : m_handle(std::exchange(other.m_handle, {})) {}
+    task(const task&)            = delete;
+    task& operator=(const task&) = delete;
+    task& operator=(task&&)      = delete;
+
+    ~task()
+    {
+        if (this->m_handle) {
+            this->m_handle.destroy();
+        }
+    }
+
+    bool await_ready() noexcept { return false; }
+
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept
+    {
+        this->m_handle.promise().continuation = caller;
+        return this->m_handle;
+    }
+
+    bool await_resume() noexcept { return this->m_handle.promise().value; }
+
+    bool run()
+    {
+        this->m_handle.promise().continuation = std::noop_coroutine();
+        this->m_handle.resume();
+        return this->m_handle.promise().value;
+    }
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+
+    explicit task(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+};
+
+bool is_active(const wwa::opentelemetry::coroutine_span& span)
+{
+    const auto current = opentelemetry::trace::GetSpan(opentelemetry::context::RuntimeContext::GetCurrent());
+    return current->GetContext() == span.span()->GetContext();
+}
+
+/**
+ * Returns whether each span of the chain was still the active one once its child had completed.
+ */
+task traced(const tracer_t& tracer, const opentelemetry::context::Context& parent, int depth)
+{
+    opentelemetry::trace::StartSpanOptions opts;
+    opts.parent = parent;
+
+    wwa::opentelemetry::coroutine_span span(tracer, "span", opts);
+    bool ok = true;
+    if (depth > 0) {
+        ok = co_await span.wrap(traced(tracer, span.context(), depth - 1));
+    }
+
+    ok = ok && is_active(span);
+    span.end();
+    co_return ok;
+}
+
+void BM_coroutine_span(benchmark::State& state, int depth)
+{
+    wwa::opentelemetry::bench::install_sdk_providers();
+
+    const auto tracer = wwa::opentelemetry::get_tracer("bench");
+    const auto before = wwa::opentelemetry::bench::allocation_count();
+    for (auto _ : state) {
+        const auto root = opentelemetry::context::RuntimeContext::GetCurrent();
+        auto t          = traced(tracer, root, depth);
+        if (!t.run() || !(opentelemetry::context::RuntimeContext::GetCurrent() == root)) {
+            state.SkipWithError("A nested coroutine_span lost the context of its parent");
+            break;
+        }
+    }
+
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(wwa::opentelemetry::bench::allocation_count() - before), benchmark::Counter::kAvgIterations
+    );
+
+    wwa::opentelemetry::bench::install_noop_providers();
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
+BENCHMARK_CAPTURE(BM_coroutine_span, single, 0);
+BENCHMARK_CAPTURE(BM_coroutine_span, nested, 3);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
@@ -0,0 +1,142 @@
+#include "fixtures.h"
+
+#include <chrono>
+#include <memory>
+#include <utility>
+
+#include <opentelemetry/context/propagation/global_propagator.h>
+#include <opentelemetry/context/propagation/noop_propagator.h>
+#include <opentelemetry/logs/noop.h>
+#include <opentelemetry/logs/provider.h>
+#include <opentelemetry/metrics/noop.h>
+#include <opentelemetry/metrics/provider.h>
+#include <opentelemetry/nostd/shared_ptr.h>
+#include <opentelemetry/nostd/span.h>
+#include <opentelemetry/sdk/common/exporter_utils.h>
+#include <opentelemetry/sdk/logs/read_write_log_record.h>
+#include <opentelemetry/sdk/logs/recordable.h>
+#include <opentelemetry/sdk/metrics/export/metric_producer.h>
+#include <opentelemetry/sdk/metrics/instruments.h>
+#include <opentelemetry/sdk/trace/recordable.h>
+#include <opentelemetry/sdk/trace/span_data.h>
+#include <opentelemetry/trace/noop.h>
+#include <opentelemetry/trace/provider.h>
+
+#include "opentelemetry/configurator/wwa/utils.h"
+
+namespace {
+
+using opentelemetry::sdk::common::ExportResult;
+
+class stub_span_exporter final : public opentelemetry::sdk::trace::SpanExporter {
+public:
+    std::unique_ptr<opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override
+    {
+        return std::make_unique<opentelemetry::sdk::trace::SpanData>();
+    }
+
+    ExportResult Export(const opentelemetry::nostd::span<std::unique_ptr<opentelemetry::sdk::trace::Recordable>>&)
+        noexcept override
+    {
+        return ExportResult::kSuccess;
+    }
+
+    bool ForceFlush(std::chrono::microseconds) noexcept override { return true; }
+    bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+class stub_metric_exporter final : public opentelemetry::sdk::metrics::PushMetricExporter {
+public:
+    ExportResult Export(const opentelemetry::sdk::metrics::ResourceMetrics&) noexcept override
+    {
+        return ExportResult::kSuccess;
+    }
+
+    opentelemetry::sdk::metrics::AggregationTemporality
+    GetAggregationTemporality(opentelemetry::sdk::metrics::InstrumentType) const noexcept override
+    {
+        return opentelemetry::sdk::metrics::AggregationTemporality::kCumulative;
+    }
+
+    bool ForceFlush(std::chrono::microseconds) noexcept override { return true; }
+    bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+class stub_log_record_exporter final : public opentelemetry::sdk::logs::LogRecordExporter {
+public:
+    std::unique_ptr<opentelemetry::sdk::logs::Recordable> MakeRecordable() noexcept override
+    {
+        return std::make_unique<opentelemetry::sdk::logs::ReadWriteLogRecord>();
+    }
+
+    ExportResult Export(const opentelemetry::nostd::span<std::unique_ptr<opentelemetry::sdk::logs::Recordable>>&)
+        noexcept override
+    {
+        return ExportResult::kSuccess;
+    }
+
+    bool ForceFlush(std::chrono::microseconds) noexcept override { return true; }
+    bool Shutdown(std::chrono::microseconds) noexcept override { return true; }
+};
+
+}  // namespace
+
+namespace wwa::opentelemetry::bench {
+
+span_exporter_t stub_span_exporter_factory(std::string_view name)
+{
+    return name == "stub" ? std::make_unique<stub_span_exporter>() : nullptr;
+}
+
+metric_exporter_t stub_metric_exporter_factory(std::string_view name)
+{
+    return name == "stub" ? std::make_unique<stub_metric_exporter>() : nullptr;
+}
+
+log_record_exporter_t stub_log_record_exporter_factory(std::string_view name)
+{
+    return name == "stub" ? std::make_unique<stub_log_record_exporter>() : nullptr;
+}
+
+const environment_t& stub_environment()
+{
+    static const auto env = []() {
+        auto result              = capture_environment();
+        result.traces_exporters  = {"stub"};
+        result.metrics_exporters = {"stub"};
+        result.logs_exporters    = {"stub"};
+        return result;
+    }();
+
+    return env;
+}
+
+void install_sdk_providers()
+{
+    opentelemetry_configuration_t config;
+    config.span_exporter_config.factory       = stub_span_exporter_factory;
+    config.metric_exporter_config.factory     = stub_metric_exporter_factory;
+    config.log_record_exporter_config.factory = stub_log_record_exporter_factory;
+    configure_opentelemetry(std::move(config), stub_environment());
+}
+
+void install_noop_providers()
+{
+    namespace api = ::opentelemetry;
+    using api::nostd::shared_ptr;
+
+    api::trace::Provider::SetTracerProvider(
+        shared_ptr<api::trace::TracerProvider>(new api::trace::NoopTracerProvider())
+    );
+    api::metrics::Provider::SetMeterProvider(
+        shared_ptr<api::metrics::MeterProvider>(new api::metrics::NoopMeterProvider())
+    );
+    api::logs::Provider::SetLoggerProvider(shared_ptr<api::logs::LoggerProvider>(new api::logs::NoopLoggerProvider()));
+    api::context::propagation::GlobalTextMapPropagator::SetGlobalPropagator(
+        shared_ptr<api::context::propagation::TextMapPropagator>(new api::context::propagation::NoOpPropagator())
+    );
+
+    invalidate_cached_handles();
+}
+
+}  // namespace wwa::opentelemetry::bench
@@ -0,0 +1,35 @@
+#ifndef E7A4B2C9_1D3F_4E8A_B6C5_9F0D2E1A3B47
+#define E7A4B2C9_1D3F_4E8A_B6C5_9F0D2E1A3B47
+
+#include <string_view>
+
+#include "opentelemetry/configurator/wwa/configurator.h"
+
+namespace wwa::opentelemetry::bench {
+
+/**
+ * Exporter factories recognizing the name `stub`. Stub exporters accept everything and do nothing,
+ * so that benchmarks measure the configurator and the SDK rather than the network.
+ */
+span_exporter_t stub_span_exporter_factory(std::string_view name);
+metric_exporter_t stub_metric_exporter_factory(std::string_view name);
+log_record_exporter_t stub_log_record_exporter_factory(std::string_view name);
+
+/**
+ * Snapshot of the process environment with OTEL_*_EXPORTER pointing at the stub exporters.
+ */
+const environment_t& stub_environment();
+
+/**
+ * Installs SDK providers with stub exporters as the global providers.
+ */
+void install_sdk_providers();
+
+/**
+ * Resets the global providers and propagator to their noop counterparts.
+ */
+void install_noop_providers();
+
+}  // namespace wwa::opentelemetry::bench
+
+#endif /* E7A4B2C9_1D3F_4E8A_B6C5_9F0D2E1A3B47 */
@@ -0,0 +1,57 @@
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+
+#include "alloc_counter.h"
+#include "fixtures.h"
+#include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/utils.h"
+
+namespace {
+
+using namespace wwa::opentelemetry;
+
+meter_provider_t make_meter_provider(const std::string& exemplar_filter)
+{
+    auto env                    = bench::stub_environment();
+    env.metrics_exemplar_filter = exemplar_filter;
+
+    meter_provider_config_t config;
+    config.metric_exporter_config.factory = bench::stub_metric_exporter_factory;
+    return configure_meter_provider(std::move(config), env);
+}
+
+/**
+ * Records into a counter from within a sampled span, which is when the trace_based filter offers the measurements
+ * to the exemplar reservoir.
+ */
+void BM_counter_add(benchmark::State& state, const std::string& exemplar_filter)
+{
+    bench::install_sdk_providers();
+
+    const auto provider = make_meter_provider(exemplar_filter);
+    const auto counter  = provider->GetMeter("bench")->CreateUInt64Counter("counter");
+
+    startActiveSpan(get_tracer("bench"), "parent", [&state, &counter](const span_t&) {
+        const auto before = bench::allocation_count();
+        for (auto _ : state) {
+            counter->Add(1);
+        }
+
+        state.counters["allocs"] = benchmark::Counter(
+            static_cast<double>(bench::allocation_count() - before), benchmark::Counter::kAvgIterations
+        );
+    });
+
+    bench::install_noop_providers();
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
+BENCHMARK_CAPTURE(BM_counter_add, always_off, std::string("always_off"));
+BENCHMARK_CAPTURE(BM_counter_add, trace_based, std::string("trace_based"));
+BENCHMARK_CAPTURE(BM_counter_add, always_on, std::string("always_on"));
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
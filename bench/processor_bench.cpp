@@ -0,0 +1,59 @@
+#include <memory>
+#include <string_view>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include <opentelemetry/nostd/shared_ptr.h>
+#include <opentelemetry/sdk/resource/resource.h>
+#include <opentelemetry/sdk/trace/samplers/always_on_factory.h>
+#include <opentelemetry/trace/tracer.h>
+
+#include "fixtures.h"
+#include "opentelemetry/configurator/wwa/configurator.h"
+
+namespace {
+
+using tracer_t = opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer>;
+
+tracer_t make_tracer(std::string_view impl)
+{
+    using namespace wwa::opentelemetry;
+
+    auto env     = bench::stub_environment();
+    env.bsp.impl = impl;
+
+    tracer_provider_config_t config;
+    config.span_exporter_config.factory = bench::stub_span_exporter_factory;
+    config.resource                     = opentelemetry::sdk::resource::Resource::Create({});
+    config.tracing_sampler              = opentelemetry::sdk::trace::AlwaysOnSamplerFactory::Create();
+
+    // The SDK tracer shares ownership of the tracer context, so the provider does not have to outlive it
+    const auto provider = configure_tracer_provider(std::move(config), env);
+    return provider->GetTracer("bench");
+}
+
+/**
+ * Span throughput through the batching span processor selected by OTEL_BSP_IMPL, with all threads ending spans
+ * into the same processor.
+ */
+void BM_span_processor(benchmark::State& state, std::string_view impl)
+{
+    static const tracer_t batch_tracer   = make_tracer("batch");
+    static const tracer_t ring_tracer    = make_tracer("ring");
+    static const tracer_t sharded_tracer = make_tracer("sharded");
+
+    const auto& tracer = impl == "ring" ? ring_tracer : (impl == "sharded" ? sharded_tracer : batch_tracer);
+    for (auto _ : state) {
+        tracer->StartSpan("span")->End();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
+BENCHMARK_CAPTURE(BM_span_processor, batch, "batch")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_CAPTURE(BM_span_processor, ring, "ring")->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_CAPTURE(BM_span_processor, sharded, "sharded")->ThreadRange(1, 64)->UseRealTime();
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
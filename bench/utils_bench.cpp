@@ -0,0 +1,201 @@
+#include <stdexcept>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include <opentelemetry/nostd/shared_ptr.h>
+#include <opentelemetry/sdk/resource/resource.h>
+#include <opentelemetry/sdk/trace/samplers/always_off_factory.h>
+#include <opentelemetry/sdk/trace/samplers/always_on_factory.h>
+#include <opentelemetry/sdk/trace/simple_processor_factory.h>
+#include <opentelemetry/sdk/trace/tracer_provider_factory.h>
+#include <opentelemetry/trace/tracer.h>
+
+#include "alloc_counter.h"
+#include "fixtures.h"
+#include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/utils.h"
+
+namespace {
+
+using tracer_t = opentelemetry::nostd::shared_ptr<opentelemetry::trace::Tracer>;
+using wwa::opentelemetry::span_t;
+
+tracer_t make_tracer(wwa::opentelemetry::tracing_sampler_t&& sampler)
+{
+    using namespace opentelemetry::sdk::trace;
+
+    // The SDK tracer shares ownership of the tracer context, so the provider does not have to outlive it
+    auto provider = TracerProviderFactory::Create(
+        SimpleSpanProcessorFactory::Create(wwa::opentelemetry::bench::stub_span_exporter_factory("stub")),
+        opentelemetry::sdk::resource::Resource::Create({}), std::move(sampler)
+    );
+
+    return provider->GetTracer("bench");
+}
+
+const tracer_t& get_bench_tracer(bool sampled)
+{
+    using namespace opentelemetry::sdk::trace;
+
+    static const tracer_t sampled_tracer   = make_tracer(AlwaysOnSamplerFactory::Create());
+    static const tracer_t unsampled_tracer = make_tracer(AlwaysOffSamplerFactory::Create());
+    return sampled ? sampled_tracer : unsampled_tracer;
+}
+
+template<typename F>
+void measure(benchmark::State& state, F&& f)
+{
+    const auto before = wwa::opentelemetry::bench::allocation_count();
+    for (auto _ : state) {
+        f();
+    }
+
+    state.counters["allocs"] = benchmark::Counter(
+        static_cast<double>(wwa::opentelemetry::bench::allocation_count() - before), benchmark::Counter::kAvgIterations
+    );
+}
+
+void BM_startSpan(benchmark::State& state, bool sampled)
+{
+    const auto& tracer = get_bench_tracer(sampled);
+    measure(state, [&tracer]() {
+        wwa::opentelemetry::startSpan(tracer, "span", [](const span_t& span) { benchmark::DoNotOptimize(span); });
+    });
+}
+
+void BM_startSpan_disabled(benchmark::State& state)
+{
+    const auto& tracer = get_bench_tracer(true);
+    wwa::opentelemetry::tracing_enabled.store(false);
+    measure(state, [&tracer]() {
+        wwa::opentelemetry::startSpan(tracer, "span", [](const span_t& span) { benchmark::DoNotOptimize(span); });
+    });
+    wwa::opentelemetry::tracing_enabled.store(true);
+}
+
+void BM_startSpan_exception(benchmark::State& state, bool sampled)
+{
+    const auto& tracer = get_bench_tracer(sampled);
+    measure(state, [&tracer]() {
+        try {
+            wwa::opentelemetry::startSpan(tracer, "span", [](const span_t&) { throw std::runtime_error("error"); });
+        }
+        catch (const std::runtime_error&) {  // NOLINT(bugprone-empty-catch)
+        }
+    });
+}
+
+void BM_startActiveSpan(benchmark::State& state, bool sampled)
+{
+    const auto& tracer = get_bench_tracer(sampled);
+    measure(state, [&tracer]() {
+        wwa::opentelemetry::startActiveSpan(tracer, "span", [](const span_t& span) {
+            benchmark::DoNotOptimize(span);
+        });
+    });
+}
+
+void BM_startActiveSpan_exception(benchmark::State& state, bool sampled)
+{
+    const auto& tracer = get_bench_tracer(sampled);
+    measure(state, [&tracer]() {
+        try {
+            wwa::opentelemetry::startActiveSpan(tracer, "span", [](const span_t&) {
+                throw std::runtime_error("error");
+            });
+        }
+        catch (const std::runtime_error&) {  // NOLINT(bugprone-empty-catch)
+        }
+    });
+}
+
+void BM_bind_context(benchmark::State& state, bool active)
+{
+    const auto run = [&state]() {
+        measure(state, []() {
+            auto task = wwa::opentelemetry::bind_context([]() { benchmark::DoNotOptimize(0); });
+            task();
+        });
+    };
+
+    if (active) {
+        wwa::opentelemetry::startActiveSpan(get_bench_tracer(true), "parent", [&run](const span_t&) { run(); });
+    }
+    else {
+        run();
+    }
+}
+
+void BM_get_tracer(benchmark::State& state, bool sdk)
+{
+    if (sdk) {
+        wwa::opentelemetry::bench::install_sdk_providers();
+    }
+    else {
+        wwa::opentelemetry::bench::install_noop_providers();
+    }
+
+    measure(state, []() { benchmark::DoNotOptimize(wwa::opentelemetry::get_tracer("bench")); });
+}
+
+void BM_get_meter(benchmark::State& state, bool sdk)
+{
+    if (sdk) {
+        wwa::opentelemetry::bench::install_sdk_providers();
+    }
+    else {
+        wwa::opentelemetry::bench::install_noop_providers();
+    }
+
+    measure(state, []() { benchmark::DoNotOptimize(wwa::opentelemetry::get_meter("bench")); });
+}
+
+void BM_get_logger(benchmark::State& state, bool sdk)
+{
+    if (sdk) {
+        wwa::opentelemetry::bench::install_sdk_providers();
+    }
+    else {
+        wwa::opentelemetry::bench::install_noop_providers();
+    }
+
+    measure(state, []() { benchmark::DoNotOptimize(wwa::opentelemetry::get_logger("bench")); });
+}
+
+void BM_cached_tracer(benchmark::State& state, bool sdk)
+{
+    if (sdk) {
+        wwa::opentelemetry::bench::install_sdk_providers();
+    }
+    else {
+        wwa::opentelemetry::bench::install_noop_providers();
+    }
+
+    const wwa::opentelemetry::cached_tracer tracer("bench");
+    measure(state, [&tracer]() { benchmark::DoNotOptimize(tracer.get()); });
+}
+
+}  // namespace
+
+// NOLINTBEGIN(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
+BENCHMARK_CAPTURE(BM_startSpan, sampled, true);
+BENCHMARK_CAPTURE(BM_startSpan, unsampled, false);
+BENCHMARK(BM_startSpan_disabled);
+BENCHMARK_CAPTURE(BM_startSpan_exception, sampled, true);
+BENCHMARK_CAPTURE(BM_startSpan_exception, unsampled, false);
+BENCHMARK_CAPTURE(BM_startActiveSpan, sampled, true);
+BENCHMARK_CAPTURE(BM_startActiveSpan, unsampled, false);
+BENCHMARK_CAPTURE(BM_startActiveSpan_exception, sampled, true);
+BENCHMARK_CAPTURE(BM_startActiveSpan_exception, unsampled, false);
+BENCHMARK_CAPTURE(BM_bind_context, no_span, false);
+BENCHMARK_CAPTURE(BM_bind_context, active_span, true);
+
+BENCHMARK_CAPTURE(BM_get_tracer, noop, false);
+BENCHMARK_CAPTURE(BM_get_meter, noop, false);
+BENCHMARK_CAPTURE(BM_get_logger, noop, false);
+BENCHMARK_CAPTURE(BM_get_tracer, sdk, true);
+BENCHMARK_CAPTURE(BM_get_meter, sdk, true);
+BENCHMARK_CAPTURE(BM_get_logger, sdk, true);
+BENCHMARK_CAPTURE(BM_cached_tracer, noop, false);
+BENCHMARK_CAPTURE(BM_cached_tracer, sdk, true);
+// NOLINTEND(cert-err58-cpp,cppcoreguidelines-avoid-non-const-global-variables,cppcoreguidelines-owning-memory)
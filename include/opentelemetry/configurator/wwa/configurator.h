@@ -1,6 +1,7 @@
 #ifndef D5C70C0F_B39A_4F49_8994_A8DF90B94923
 #define D5C70C0F_B39A_4F49_8994_A8DF90B94923
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -23,6 +24,7 @@
 #include <opentelemetry/sdk/trace/sampler.h>
 #include <opentelemetry/sdk/trace/tracer_provider.h>
 
+#include "environment.h"
 #include "export.h"
 
 namespace wwa::opentelemetry {
@@ -60,6 +62,17 @@ struct resource_config_t {
     ::opentelemetry::sdk::resource::ResourceAttributes attrs;
     std::string schema_url;
     std::vector<std::shared_ptr<::opentelemetry::sdk::resource::ResourceDetector>> detectors;
+    // Detectors run concurrently; a detector that misses either deadline is skipped. Zero means no deadline.
+    std::chrono::milliseconds detector_timeout{0};
+    std::chrono::milliseconds detection_timeout{0};
+    // Optional file, shared between processes, caching detector results. Stale entries are refreshed by running
+    // the detector again, and are only used when it fails or misses its deadline.
+    std::string detector_cache_path;
+    // Cache keys of the detectors, by position. A missing or empty key defaults to the type of the detector and its
+    // position among the detectors of that type; give detectors of the same type configured differently across
+    // processes distinct keys.
+    std::vector<std::string> detector_cache_keys;
+    std::chrono::seconds detector_cache_ttl{3600};
 };
 
 struct log_record_exporter_config_t {
@@ -108,6 +121,8 @@ struct tracer_provider_config_t {
 struct opentelemetry_configuration_t {
     // Global
     std::variant<resource_config_t, ::opentelemetry::sdk::resource::Resource> resource;
+    // Build TracerProvider, MeterProvider, and LoggerProvider in parallel; the globals are still installed in order
+    bool concurrent_initialization = false;
 
     // TracerProvider
     span_exporter_config_t span_exporter_config;
@@ -127,25 +142,45 @@ struct opentelemetry_configuration_t {
     std::vector<log_record_processor_t> log_processors;
 };
 
+// The overloads without an environment_t argument use a snapshot of the process environment, captured once
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void configure_internal_logging_from_environment();
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void configure_internal_logging_from_environment(const environment_t& env);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT std::vector<log_record_exporter_t>
 configure_log_record_exporters_from_environment(const log_record_exporter_config_t& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT std::vector<log_record_exporter_t>
+configure_log_record_exporters_from_environment(const log_record_exporter_config_t& opts, const environment_t& env);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT std::vector<metric_exporter_t>
 configure_metric_exporters_from_environment(const metric_exporter_config_t& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT std::vector<metric_exporter_t>
+configure_metric_exporters_from_environment(const metric_exporter_config_t& opts, const environment_t& env);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT std::vector<span_exporter_t>
 configure_span_exporters_from_environment(const span_exporter_config_t& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT std::vector<span_exporter_t>
+configure_span_exporters_from_environment(const span_exporter_config_t& opts, const environment_t& env);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT propagator_t
 configure_propagators_from_environment(const propagator_config_t& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT propagator_t
+configure_propagators_from_environment(const propagator_config_t& opts, const environment_t& env);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT tracing_sampler_t
 configure_tracing_sampler_from_environment(tracing_sampler_config_t&& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT tracing_sampler_t
+configure_tracing_sampler_from_environment(tracing_sampler_config_t&& opts, const environment_t& env);
 
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT logger_provider_t configure_logger_provider(logger_provider_config_t&& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT logger_provider_t
+configure_logger_provider(logger_provider_config_t&& opts, const environment_t& env);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT meter_provider_t configure_meter_provider(meter_provider_config_t&& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT meter_provider_t
+configure_meter_provider(meter_provider_config_t&& opts, const environment_t& env);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT ::opentelemetry::sdk::resource::Resource
 configure_resource(const resource_config_t& opts);
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT tracer_provider_t configure_tracer_provider(tracer_provider_config_t&& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT tracer_provider_t
+configure_tracer_provider(tracer_provider_config_t&& opts, const environment_t& env);
 
 WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void configure_opentelemetry(opentelemetry_configuration_t&& opts);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void
+configure_opentelemetry(opentelemetry_configuration_t&& opts, const environment_t& env);
 
 }  // namespace wwa::opentelemetry
 
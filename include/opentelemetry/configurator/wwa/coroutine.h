@@ -0,0 +1,249 @@
+#ifndef E3A8C5D1_9F42_4B6E_A07C_2D5F8B1E4C93
+#define E3A8C5D1_9F42_4B6E_A07C_2D5F8B1E4C93
+
+#include <coroutine>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+#include <opentelemetry/context/context.h>
+#include <opentelemetry/context/runtime_context.h>
+#include <opentelemetry/nostd/shared_ptr.h>
+#include <opentelemetry/nostd/string_view.h>
+#include <opentelemetry/nostd/unique_ptr.h>
+#include <opentelemetry/trace/context.h>
+#include <opentelemetry/trace/span.h>
+#include <opentelemetry/trace/span_metadata.h>
+#include <opentelemetry/trace/span_startoptions.h>
+#include <opentelemetry/trace/tracer.h>
+
+#include "utils.h"
+
+namespace wwa::opentelemetry {
+
+namespace coroutine_detail {
+
+template<typename Awaitable>
+decltype(auto) get_awaiter(Awaitable&& awaitable)
+{
+    if constexpr (requires { std::forward<Awaitable>(awaitable).operator co_await(); }) {
+        return std::forward<Awaitable>(awaitable).operator co_await();
+    }
+    else if constexpr (requires { operator co_await(std::forward<Awaitable>(awaitable)); }) {
+        return operator co_await(std::forward<Awaitable>(awaitable));
+    }
+    else {
+        return std::forward<Awaitable>(awaitable);
+    }
+}
+
+}  // namespace coroutine_detail
+
+/**
+ * The runtime context of a coroutine.
+ *
+ * The OpenTelemetry runtime context is thread-local, while a coroutine may suspend on one thread and resume on
+ * another. Keep the object in the coroutine frame and co_await through `wrap()`: the context is detached from the
+ * thread before the coroutine suspends, and attached to the thread that resumes it.
+ *
+ * Call `detach()` right before the coroutine completes. The frame is often destroyed only after the awaiting
+ * coroutine has resumed and attached its own context, or on another thread: detaching from the destructor would then
+ * pop the awaiting coroutine's context as well, or detach from the wrong thread.
+ */
+class coroutine_context {
+public:
+    template<typename Awaitable>
+    class awaiter;
+
+    // Attaches `context` to the calling thread, and to the threads that resume the coroutine, unless `active` is false
+    explicit coroutine_context(::opentelemetry::context::Context context, bool active = true)
+        : m_context(std::move(context)), m_active(active)
+    {
+        this->attach();
+    }
+
+    coroutine_context(const coroutine_context&)            = delete;
+    coroutine_context(coroutine_context&&)                 = delete;
+    coroutine_context& operator=(const coroutine_context&) = delete;
+    coroutine_context& operator=(coroutine_context&&)      = delete;
+
+    ~coroutine_context() = default;
+
+    [[nodiscard]] const ::opentelemetry::context::Context& context() const noexcept { return this->m_context; }
+
+    void attach() noexcept
+    {
+        if (this->m_active && !this->m_token) {
+            this->m_token = ::opentelemetry::context::RuntimeContext::Attach(this->m_context);
+        }
+    }
+
+    void detach() noexcept { this->m_token = nullptr; }
+
+    template<typename Awaitable>
+    [[nodiscard]] awaiter<Awaitable> wrap(Awaitable&& awaitable)
+    {
+        return awaiter<Awaitable>(*this, std::forward<Awaitable>(awaitable));
+    }
+
+private:
+    ::opentelemetry::context::Context m_context;
+    ::opentelemetry::nostd::unique_ptr<::opentelemetry::context::Token> m_token;
+    bool m_active;
+};
+
+template<typename Awaitable>
+class coroutine_context::awaiter {
+public:
+    awaiter(coroutine_context& context, Awaitable&& awaitable)
+        : m_context(context), m_awaitable(std::forward<Awaitable>(awaitable)),
+          m_awaiter(coroutine_detail::get_awaiter(std::forward<Awaitable>(m_awaitable)))
+    {
+    }
+
+    // Only ever used as a temporary: the awaiter may refer to the awaitable
+    awaiter(const awaiter&)            = delete;
+    awaiter(awaiter&&)                 = delete;
+    awaiter& operator=(const awaiter&) = delete;
+    awaiter& operator=(awaiter&&)      = delete;
+
+    ~awaiter() = default;
+
+    bool await_ready() { return this->m_awaiter.await_ready(); }
+
+    template<typename Promise>
+    auto await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        // Detach first: once the inner awaiter has the handle, another thread may resume the coroutine at any time
+        this->m_context.detach();
+        try {
+            if constexpr (std::is_void_v<decltype(this->m_awaiter.await_suspend(handle))>) {
+                this->m_awaiter.await_suspend(handle);
+            }
+            else {
+                return this->m_awaiter.await_suspend(handle);
+            }
+        }
+        catch (...) {
+            // The coroutine is resumed right away, and await_resume() is not called
+            this->m_context.attach();
+            throw;
+        }
+    }
+
+    decltype(auto) await_resume()
+    {
+        // Also called without a suspension, when await_ready() or await_suspend() says so; attach() is idempotent
+        this->m_context.attach();
+        return this->m_awaiter.await_resume();
+    }
+
+private:
+    coroutine_context& m_context;
+    Awaitable m_awaitable;  // A reference when `wrap()` was given an lvalue
+    decltype(coroutine_detail::get_awaiter(std::declval<Awaitable>())) m_awaiter;
+};
+
+/**
+ * A span for a coroutine: lives in the coroutine frame, is active whenever the coroutine runs, and ends with
+ * `end()`, which must be called right before the coroutine completes (see `coroutine_context`). The destructor
+ * ends the span if `end()` has not been called, but the context is then detached too late.
+ *
+ * The co_awaits of the coroutine must go through `wrap()`, so that the span follows the coroutine from thread to
+ * thread. A lazily started child coroutine does not run in the context of its caller: pass it the parent
+ * explicitly, e.g. through `StartSpanOptions::parent = parent.context()`.
+ *
+ * Suspending does not allocate, but resuming does: `RuntimeContext::Attach()` returns a heap-allocated token, and
+ * only the runtime context storage can create one, so there is no token to reuse across suspensions.
+ * While tracing is disabled (see `is_tracing_enabled()`), or with a noop tracer, the span is a noop one and nothing
+ * is attached, so that neither starting the coroutine nor resuming it allocates.
+ *
+ * @code
+ * task<response> handle(request req)
+ * {
+ *     wwa::opentelemetry::coroutine_span span(tracer, "handle");
+ *     try {
+ *         auto body   = co_await span.wrap(read_body(req));
+ *         auto result = co_await span.wrap(process(std::move(body)));
+ *         span.end();
+ *         co_return result;
+ *     }
+ *     catch (const std::exception& e) {
+ *         span.record_exception(e);
+ *         span.end();
+ *         throw;
+ *     }
+ * }
+ * @endcode
+ */
+class coroutine_span {
+public:
+    coroutine_span(
+        const ::opentelemetry::nostd::shared_ptr<::opentelemetry::trace::Tracer>& tracer,
+        ::opentelemetry::nostd::string_view name, const ::opentelemetry::trace::StartSpanOptions& opts = {}
+    )
+        : m_span(is_tracing_enabled() ? tracer->StartSpan(name, opts) : get_noop_span()),
+          m_context(make_context(this->m_span), this->m_span->GetContext().IsValid())
+    {
+    }
+
+    coroutine_span(const coroutine_span&)            = delete;
+    coroutine_span(coroutine_span&&)                 = delete;
+    coroutine_span& operator=(const coroutine_span&) = delete;
+    coroutine_span& operator=(coroutine_span&&)      = delete;
+
+    ~coroutine_span() { this->end(); }
+
+    [[nodiscard]] const span_t& span() const noexcept { return this->m_span; }
+    [[nodiscard]] const ::opentelemetry::context::Context& context() const noexcept
+    {
+        return this->m_context.context();
+    }
+
+    ::opentelemetry::trace::Span* operator->() const noexcept { return this->m_span.get(); }
+
+    // The span ends before its context is detached, like with startActiveSpan()
+    void end() noexcept
+    {
+        if (!this->m_ended) {
+            this->m_ended = true;
+            this->m_span->End();
+            this->m_context.detach();
+        }
+    }
+
+    template<typename Awaitable>
+    [[nodiscard]] coroutine_context::awaiter<Awaitable> wrap(Awaitable&& awaitable)
+    {
+        return this->m_context.wrap(std::forward<Awaitable>(awaitable));
+    }
+
+    // Records `e` and marks the span as failed, like startActiveSpan() does with the exceptions escaping `f`
+    void record_exception(const std::exception& e) const
+    {
+        if (this->m_span->IsRecording()) {
+            wwa::opentelemetry::record_exception(this->m_span, &e);
+            this->m_span->SetStatus(::opentelemetry::trace::StatusCode::kError, e.what());
+        }
+    }
+
+private:
+    span_t m_span;
+    coroutine_context m_context;
+    bool m_ended = false;
+
+    static ::opentelemetry::context::Context make_context(const span_t& span)
+    {
+        if (!span->GetContext().IsValid()) {
+            // A noop span: there is no context worth making active
+            return {};
+        }
+
+        auto current = ::opentelemetry::context::RuntimeContext::GetCurrent();
+        return ::opentelemetry::trace::SetSpan(current, span);
+    }
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* E3A8C5D1_9F42_4B6E_A07C_2D5F8B1E4C93 */
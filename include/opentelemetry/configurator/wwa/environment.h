@@ -0,0 +1,160 @@
+#ifndef F4B8D2A6_9C3E_4F71_8A5D_2E6C0B9F1D37
+#define F4B8D2A6_9C3E_4F71_8A5D_2E6C0B9F1D37
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <opentelemetry/sdk/common/global_log_handler.h>
+
+#include "export.h"
+
+namespace wwa::opentelemetry {
+
+struct batch_processor_environment_t {
+    std::chrono::milliseconds schedule_delay{5000};
+    std::size_t max_queue_size        = 2048;
+    std::size_t max_export_batch_size = 512;
+    // OTEL_BSP_MAX_QUEUE_BYTES / OTEL_BSP_MAX_EXPORT_BATCH_BYTES (and OTEL_BLRP_*): not in the specification;
+    // estimated sizes of the queued data, zero means no limit
+    std::size_t max_queue_bytes        = 0;
+    std::size_t max_export_batch_bytes = 0;
+    // Unset unless OTEL_BSP_EXPORT_TIMEOUT / OTEL_BLRP_EXPORT_TIMEOUT is set; zero means no limit
+    std::optional<std::chrono::milliseconds> export_timeout;
+    // OTEL_BSP_MAX_CONCURRENT_EXPORTS / OTEL_BLRP_MAX_CONCURRENT_EXPORTS: not in the specification; the number
+    // of batches exported at a time, each by its own instance of the exporter
+    std::size_t max_concurrent_exports = 1;
+    // OTEL_BSP_IMPL / OTEL_BLRP_IMPL: "batch" (the SDK processor), "sharded", or "ring" (spans only)
+    std::string impl = "batch";
+    // OTEL_BSP_FANOUT / OTEL_BLRP_FANOUT: a single processor delivers every batch to all configured exporters
+    bool fanout = false;
+};
+
+/**
+ * A metric view from OTEL_CPP_METRICS_VIEWS or OTEL_CPP_METRICS_VIEWS_FILE (not in the specification).
+ *
+ * A rule reads `<instrument>:<option>,<option>...`; the options are `drop`, `meter=<name>`,
+ * `cardinality_limit=<n>`, `attributes=<key>|<key>...` (the attributes to keep), and
+ * `exclude_attributes=<key>|<key>...`. In the variable, rules are separated by semicolons; in the file, by newlines,
+ * and lines starting with `#` are comments. Like any view, an instrument matched by several rules is exported once
+ * per rule. When rules are set, the default histogram aggregation only applies to the histograms they match.
+ */
+struct metric_view_rule_t {
+    std::string instrument;  // "*" matches any sequence of characters
+    std::string meter;       // Empty matches all meters
+    bool drop                     = false;
+    std::size_t cardinality_limit = 0;  // Zero means the SDK default
+    std::vector<std::string> attributes;
+    std::vector<std::string> excluded_attributes;
+};
+
+// The parts of the configuration the parse warnings are about
+enum class environment_scope_t : std::uint8_t { common, traces, metrics, logs };
+
+/**
+ * Immutable snapshot of the OTEL_* environment variables, parsed into typed fields.
+ *
+ * `capture_environment()` scans the process environment exactly once and collects the parse warnings by scope,
+ * so that they can be reported once internal logging is configured, and only for the signals that are configured.
+ * `configure_internal_logging_from_environment()` reports the common ones, and `configure_opentelemetry()` those of
+ * the signals it enables; otherwise, call `report_environment_warnings()`. The configure_* overloads without
+ * an environment argument report the warnings of the process snapshot that concern them, once per snapshot.
+ * The snapshot does not change after capture: it can be shared between threads and reused when the configuration
+ * is built more than once.
+ *
+ * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/
+ */
+struct environment_t {
+    // Raw values of all OTEL_* variables
+    std::unordered_map<std::string, std::string> variables;
+    // Parse warnings: `warnings` are common to all signals, the others only matter when the signal is configured
+    std::vector<std::string> warnings;
+    std::vector<std::string> traces_warnings;
+    std::vector<std::string> metrics_warnings;
+    std::vector<std::string> logs_warnings;
+
+    bool sdk_disabled = false;
+    ::opentelemetry::sdk::common::internal_log::LogLevel log_level =
+        ::opentelemetry::sdk::common::internal_log::LogLevel::Info;
+
+    // Exporter names; an empty list means that the signal is disabled ("none")
+    std::vector<std::string> traces_exporters;
+    std::vector<std::string> metrics_exporters;
+    std::vector<std::string> logs_exporters;
+
+    // OTLP protocols, with OTEL_EXPORTER_OTLP_PROTOCOL applied as the fallback
+    std::string traces_protocol;
+    std::string metrics_protocol;
+    std::string logs_protocol;
+
+    // Propagator names, deduplicated; an empty list means no propagation ("none")
+    std::vector<std::string> propagators;
+
+    std::string traces_sampler;
+    std::optional<double> traces_sampler_arg;
+
+    // OTEL_CPP_ID_GENERATOR: not in the specification; "random" (the SDK's generator) or "fast"
+    std::string id_generator = "random";
+
+    batch_processor_environment_t bsp;
+    batch_processor_environment_t blrp;
+
+    std::chrono::milliseconds metric_export_interval{60'000};
+    std::chrono::milliseconds metric_export_timeout{30'000};
+
+    // OTEL_EXPORTER_OTLP_METRICS_TEMPORALITY_PREFERENCE, lowercased: "cumulative", "delta", or "lowmemory"
+    std::string metrics_temporality_preference = "cumulative";
+
+    // OTEL_METRICS_EXEMPLAR_FILTER, lowercased: "always_on", "always_off", or "trace_based"
+    std::string metrics_exemplar_filter = "trace_based";
+
+    // OTEL_EXPORTER_OTLP_METRICS_DEFAULT_HISTOGRAM_AGGREGATION: "explicit_bucket_histogram" or
+    // "base2_exponential_bucket_histogram"
+    std::string metrics_default_histogram_aggregation = "explicit_bucket_histogram";
+
+    // OTEL_EXPORTER_OTLP_METRICS_EXPONENTIAL_HISTOGRAM_MAX_SIZE and _MAX_SCALE: not in the specification;
+    // the limits of the base-2 exponential histograms
+    std::size_t exponential_histogram_max_size   = 160;
+    std::int32_t exponential_histogram_max_scale = 20;
+
+    std::vector<metric_view_rule_t> metric_views;
+
+    // OTEL_EXPORT_SCHEDULER_THREADS: not in the specification; when non-zero, the processors and metric readers
+    // share a pool of that many threads instead of running one thread each
+    std::size_t export_scheduler_threads = 0;
+
+    // OTEL_SELF_TELEMETRY_ENABLED: not in the specification; reports export counts and latency of the configured
+    // pipelines through the meter provider built by configure_meter_provider(), and queue occupancy and drops
+    // of the processors implemented by this library (the SDK batch processors do not expose them)
+    bool self_telemetry = false;
+
+    [[nodiscard]] std::string get(const std::string& name) const
+    {
+        const auto it = this->variables.find(name);
+        return it != this->variables.end() ? it->second : std::string();
+    }
+};
+
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT environment_t capture_environment();
+// Reports all warnings, or only those of `scope`
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void report_environment_warnings(const environment_t& env);
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void
+report_environment_warnings(const environment_t& env, environment_scope_t scope);
+
+/**
+ * The configure_* overloads without an environment_t argument share a snapshot of the process environment,
+ * captured on first use. `invalidate_process_environment()` discards it, so that the next such call captures
+ * a new one; `reload_process_environment()` captures a new snapshot right away and returns it.
+ * Providers that have already been built keep the options they were built with.
+ */
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void invalidate_process_environment();
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT std::shared_ptr<const environment_t> reload_process_environment();
+
+}  // namespace wwa::opentelemetry
+
+#endif /* F4B8D2A6_9C3E_4F71_8A5D_2E6C0B9F1D37 */
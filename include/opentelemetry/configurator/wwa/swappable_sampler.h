@@ -0,0 +1,84 @@
+#ifndef F1F5D05D_A50B_4ABB_9160_1072A11F553D
+#define F1F5D05D_A50B_4ABB_9160_1072A11F553D
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+#include <opentelemetry/sdk/trace/sampler.h>
+
+#include "configurator.h"
+#include "environment.h"
+#include "export.h"
+
+namespace wwa::opentelemetry {
+
+/**
+ * Sampler whose delegate can be replaced at runtime, e.g., to cut the tracing volume during an incident
+ * without restarting the process.
+ *
+ * `ShouldSample()` stays lock-free: it loads the current delegate and marks itself as in flight in a counter
+ * picked by the calling thread. A swap waits until the calls that may still use the replaced delegate have
+ * returned, then destroys it; it must therefore not be called from within `ShouldSample()` of a delegate.
+ *
+ * `request_reload()` is async-signal-safe: a signal handler (e.g., for SIGHUP) can call it. The request is carried
+ * out, outside of the span path, by `reload_if_requested()`: the shared export scheduler calls it every second when
+ * OTEL_EXPORT_SCHEDULER_THREADS is set; otherwise, the application calls it, e.g., from its main loop.
+ *
+ * A reload that asks for a sampler the span pipeline cannot support (the adaptive sampler needs span processors
+ * built for it) keeps the current sampler and logs a warning.
+ */
+class export_scheduler;
+
+class WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT swappable_sampler : public ::opentelemetry::sdk::trace::Sampler {
+public:
+    // Uses the sampler configured by the process environment
+    explicit swappable_sampler(tracing_sampler_config_t opts = {});
+    swappable_sampler(tracing_sampler_t delegate, tracing_sampler_config_t opts = {});
+    swappable_sampler(const swappable_sampler&)            = delete;
+    swappable_sampler& operator=(const swappable_sampler&) = delete;
+    swappable_sampler(swappable_sampler&&)                 = delete;
+    swappable_sampler& operator=(swappable_sampler&&)      = delete;
+    ~swappable_sampler() override;
+
+    ::opentelemetry::sdk::trace::SamplingResult ShouldSample(
+        const ::opentelemetry::trace::SpanContext& parent_context, ::opentelemetry::trace::TraceId trace_id,
+        ::opentelemetry::nostd::string_view name, ::opentelemetry::trace::SpanKind span_kind,
+        const ::opentelemetry::common::KeyValueIterable& attributes,
+        const ::opentelemetry::trace::SpanContextKeyValueIterable& links
+    ) noexcept override;
+
+    [[nodiscard]] ::opentelemetry::nostd::string_view GetDescription() const noexcept override;
+
+    void swap(tracing_sampler_t delegate);
+    // Installs ParentBased(TraceIdRatioBased(ratio)); the ratio is clamped to [0, 1]
+    void set_ratio(double ratio);
+    void reload(const environment_t& env);
+    // Re-reads the sampler variables of the process environment; the shared snapshot is left alone
+    void reload();
+    void request_reload() noexcept;
+    // Reloads if request_reload() has been called since the last reload; returns whether it has
+    bool reload_if_requested();
+
+private:
+    struct readers_t;
+
+    std::atomic<::opentelemetry::sdk::trace::Sampler*> m_delegate{nullptr};
+    std::unique_ptr<readers_t> m_readers;  // The ShouldSample() calls in flight
+    std::mutex m_mutex;                    // Serializes swaps
+    tracing_sampler_t m_current;
+    tracing_sampler_config_t m_config;
+
+    std::atomic<bool> m_reload_requested{false};
+    std::shared_ptr<export_scheduler> m_scheduler;  // Only set when the shared export scheduler is configured
+    std::uint64_t m_reload_task = 0;
+
+    void install(const environment_t& env);
+    void schedule_reloads();
+    void wait_for_readers() noexcept;
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* F1F5D05D_A50B_4ABB_9160_1072A11F553D */
@@ -1,23 +1,34 @@
 #ifndef B9313F7F_096F_47E8_9AAA_B3828659B876
 #define B9313F7F_096F_47E8_9AAA_B3828659B876
 
+#include <atomic>
+#include <cstdint>
 #include <exception>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
+#include <opentelemetry/context/context.h>
+#include <opentelemetry/context/runtime_context.h>
 #include <opentelemetry/logs/logger.h>
 #include <opentelemetry/logs/provider.h>
 #include <opentelemetry/metrics/meter.h>
 #include <opentelemetry/metrics/provider.h>
 #include <opentelemetry/nostd/shared_ptr.h>
 #include <opentelemetry/nostd/string_view.h>
+#include <opentelemetry/nostd/unique_ptr.h>
 #include <opentelemetry/trace/provider.h>
 #include <opentelemetry/trace/span.h>
 #include <opentelemetry/trace/span_metadata.h>
 #include <opentelemetry/trace/span_startoptions.h>
 #include <opentelemetry/trace/tracer.h>
 
+#include "export.h"
+
 namespace wwa::opentelemetry {
 
 using span_t = ::opentelemetry::nostd::shared_ptr<::opentelemetry::trace::Span>;
@@ -37,16 +48,33 @@ private:
 
 void record_exception(const span_t& span, const std::exception* e);
 
+/**
+ * Cleared by configure_opentelemetry() when OTEL_SDK_DISABLED is true; applications that install the noop
+ * tracer provider by other means may clear it themselves. While it is clear, the span helpers below call `f`
+ * with a shared invalid span, without asking the tracer for a span.
+ */
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT extern std::atomic<bool> tracing_enabled;
+
+inline bool is_tracing_enabled() noexcept
+{
+    return tracing_enabled.load(std::memory_order_relaxed);
+}
+
+// The non-recording span passed to the callbacks of the span helpers while tracing is disabled
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT const span_t& get_noop_span() noexcept;
+
+/**
+ * Calls `f` with `span`, recording an exception escaping `f` on the span; a span that is not recording
+ * (unsampled, or from a noop tracer) would discard the exception anyway, so `f` is called directly.
+ */
 template<typename F, typename... Args>
-inline std::invoke_result_t<std::decay_t<F>, span_t, Args...> startActiveSpan(
-    const ::opentelemetry::nostd::shared_ptr<::opentelemetry::trace::Tracer>& tracer,
-    ::opentelemetry::nostd::string_view name, const ::opentelemetry::trace::StartSpanOptions& opts, F&& f,
-    Args&&... args
-)
+inline std::invoke_result_t<std::decay_t<F>, span_t, Args...>
+invoke_with_span(const span_t& span, F&& f, Args&&... args)
 {
-    auto span  = tracer->StartSpan(name, opts);
-    auto scope = ::opentelemetry::trace::Tracer::WithActiveSpan(span);
-    const span_ender ender(span);
+    if (!span->IsRecording()) {
+        return std::invoke(std::forward<F>(f), span, std::forward<Args>(args)...);
+    }
+
     try {
         return std::invoke(std::forward<F>(f), span, std::forward<Args>(args)...);
     }
@@ -57,6 +85,30 @@ inline std::invoke_result_t<std::decay_t<F>, span_t, Args...> startActiveSpan(
     }
 }
 
+template<typename F, typename... Args>
+inline std::invoke_result_t<std::decay_t<F>, span_t, Args...> startActiveSpan(
+    const ::opentelemetry::nostd::shared_ptr<::opentelemetry::trace::Tracer>& tracer,
+    ::opentelemetry::nostd::string_view name, const ::opentelemetry::trace::StartSpanOptions& opts, F&& f,
+    Args&&... args
+)
+{
+    if (!is_tracing_enabled()) [[unlikely]] {
+        return std::invoke(std::forward<F>(f), get_noop_span(), std::forward<Args>(args)...);
+    }
+
+    auto span = tracer->StartSpan(name, opts);
+    if (!span->GetContext().IsValid()) {
+        // A noop tracer: there is no context worth making active.
+        // An unsampled span, on the other hand, has to become active, so that its children are not sampled either
+        const span_ender ender(span);
+        return std::invoke(std::forward<F>(f), span, std::forward<Args>(args)...);
+    }
+
+    auto scope = ::opentelemetry::trace::Tracer::WithActiveSpan(span);
+    const span_ender ender(span);
+    return invoke_with_span(span, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
 template<typename F, typename... Args>
 inline std::invoke_result_t<std::decay_t<F>, span_t, Args...> startActiveSpan(
     const ::opentelemetry::nostd::shared_ptr<::opentelemetry::trace::Tracer>& tracer,
@@ -73,16 +125,13 @@ inline std::invoke_result_t<std::decay_t<F>, span_t, Args...> startSpan(
     Args&&... args
 )
 {
+    if (!is_tracing_enabled()) [[unlikely]] {
+        return std::invoke(std::forward<F>(f), get_noop_span(), std::forward<Args>(args)...);
+    }
+
     auto span = tracer->StartSpan(name, opts);
     const span_ender ender(span);
-    try {
-        return std::invoke(std::forward<F>(f), span, std::forward<Args>(args)...);
-    }
-    catch (const std::exception& e) {
-        record_exception(span, &e);
-        span->SetStatus(::opentelemetry::trace::StatusCode::kError, e.what());
-        throw;
-    }
+    return invoke_with_span(span, std::forward<F>(f), std::forward<Args>(args)...);
 }
 
 template<typename F, typename... Args>
@@ -116,6 +165,187 @@ static inline ::opentelemetry::nostd::shared_ptr<::opentelemetry::logs::Logger>
     return ::opentelemetry::logs::Provider::GetLoggerProvider()->GetLogger(logger_name, library_name, library_version);
 }
 
+/**
+ * Bumped whenever configure_opentelemetry() installs the global providers; `invalidate_cached_handles()` bumps it
+ * after a global provider has been replaced by other means. A direct `Provider::Set*Provider()` call is not
+ * detected: the cached handles keep using the old provider until `invalidate_cached_handles()` is called.
+ */
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT const std::atomic<std::uint64_t>& get_provider_generation() noexcept;
+WWA_OPENTELEMETRY_CONFIGURATOR_EXPORT void invalidate_cached_handles() noexcept;
+
+/**
+ * A tracer, meter or logger looked up from the global provider on first use, and again only after the provider
+ * has been replaced: `get()` costs two atomic loads.
+ *
+ * The reference returned by `get()` stays valid for the lifetime of the handle. To keep it so, the handle retains
+ * the tracers (meters, loggers) it looked up before the provider was replaced, and with them the replaced providers,
+ * along with their processors, exporters and threads. Call `release_superseded()` once no reference from an earlier
+ * `get()` is in use anymore, e.g. after reconfiguring at a quiescent point, to let them go.
+ */
+template<typename T>
+class cached_handle {
+public:
+    using handle_t = ::opentelemetry::nostd::shared_ptr<T>;
+
+    explicit cached_handle(std::function<handle_t()> lookup)
+        : m_generation(&get_provider_generation()), m_lookup(std::move(lookup))
+    {
+    }
+
+    cached_handle(const cached_handle&)            = delete;
+    cached_handle(cached_handle&&)                 = delete;
+    cached_handle& operator=(const cached_handle&) = delete;
+    cached_handle& operator=(cached_handle&&)      = delete;
+
+    ~cached_handle() = default;
+
+    const handle_t& get() const
+    {
+        const auto generation = this->m_generation->load(std::memory_order_acquire);
+        const auto* entry     = this->m_current.load(std::memory_order_acquire);
+        if (entry != nullptr && entry->generation == generation) [[likely]] {
+            return entry->handle;
+        }
+
+        return this->refresh(generation);
+    }
+
+    T* operator->() const { return this->get().get(); }
+
+    // Frees the handles looked up before the current one: the references earlier get() calls returned must be unused
+    void release_superseded()
+    {
+        const std::lock_guard lock(this->m_mutex);
+        const auto* current = this->m_current.load(std::memory_order_relaxed);
+        std::erase_if(this->m_entries, [current](const auto& entry) { return entry.get() != current; });
+    }
+
+private:
+    struct entry_t {
+        std::uint64_t generation;
+        handle_t handle;
+    };
+
+    const std::atomic<std::uint64_t>* m_generation;
+    std::function<handle_t()> m_lookup;
+    mutable std::mutex m_mutex;
+    // Superseded entries are only freed by release_superseded(): references returned by get() may still be in use
+    mutable std::vector<std::unique_ptr<entry_t>> m_entries;
+    mutable std::atomic<const entry_t*> m_current{nullptr};
+
+    const handle_t& refresh(std::uint64_t generation) const
+    {
+        const std::lock_guard lock(this->m_mutex);
+        if (const auto* entry = this->m_current.load(std::memory_order_relaxed);
+            entry != nullptr && entry->generation == generation) {
+            return entry->handle;
+        }
+
+        // The generation is read before the lookup: if the provider is replaced in between, the next get() looks again
+        this->m_entries.push_back(std::make_unique<entry_t>(entry_t{generation, this->m_lookup()}));
+        this->m_current.store(this->m_entries.back().get(), std::memory_order_release);
+        return this->m_entries.back()->handle;
+    }
+};
+
+class cached_tracer : public cached_handle<::opentelemetry::trace::Tracer> {
+public:
+    explicit cached_tracer(std::string name, std::string version = "")
+        : cached_handle([name = std::move(name), version = std::move(version)]() { return get_tracer(name, version); })
+    {
+    }
+};
+
+class cached_meter : public cached_handle<::opentelemetry::metrics::Meter> {
+public:
+    explicit cached_meter(std::string name, std::string version = "", std::string schema_url = "")
+        : cached_handle([name = std::move(name), version = std::move(version), schema_url = std::move(schema_url)]() {
+              return get_meter(name, version, schema_url);
+          })
+    {
+    }
+};
+
+class cached_logger : public cached_handle<::opentelemetry::logs::Logger> {
+public:
+    explicit cached_logger(std::string logger_name, std::string library_name = "", std::string library_version = "")
+        : cached_handle([logger_name = std::move(logger_name), library_name = std::move(library_name),
+                         library_version = std::move(library_version)]() {
+              return get_logger(logger_name, library_name, library_version);
+          })
+    {
+    }
+};
+
+/**
+ * Attaches `context` to the calling thread for the lifetime of the object, unless it already is the current one.
+ * An empty context is attached too: otherwise, the code would run under whatever context the thread has, e.g. that
+ * of a span the thread is joining or helping in.
+ */
+class context_scope {
+public:
+    explicit context_scope(const ::opentelemetry::context::Context& context) noexcept
+    {
+        if (context != ::opentelemetry::context::RuntimeContext::GetCurrent()) {
+            this->m_token = ::opentelemetry::context::RuntimeContext::Attach(context);
+        }
+    }
+
+    context_scope(const context_scope&)            = delete;
+    context_scope(context_scope&&)                 = delete;
+    context_scope& operator=(const context_scope&) = delete;
+    context_scope& operator=(context_scope&&)      = delete;
+
+    ~context_scope() = default;
+
+private:
+    ::opentelemetry::nostd::unique_ptr<::opentelemetry::context::Token> m_token;
+};
+
+/**
+ * A task carrying the runtime context it was created in: the context is attached to the thread that runs
+ * the task for the duration of the call, so that the trace survives the hop through a thread pool or an executor.
+ *
+ * Capturing the context copies a reference-counted pointer, and nothing is captured while tracing is disabled.
+ */
+template<typename F>
+class context_task {
+public:
+    explicit context_task(F f)
+        : m_f(std::move(f)),
+          m_context(
+              is_tracing_enabled() ? ::opentelemetry::context::RuntimeContext::GetCurrent()
+                                   : ::opentelemetry::context::Context{}
+          )
+    {
+    }
+
+    template<typename... Args>
+    decltype(auto) operator()(Args&&... args)
+    {
+        const context_scope scope(this->m_context);
+        return std::invoke(this->m_f, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    decltype(auto) operator()(Args&&... args) const
+    {
+        const context_scope scope(this->m_context);
+        return std::invoke(this->m_f, std::forward<Args>(args)...);
+    }
+
+private:
+    F m_f;
+    ::opentelemetry::context::Context m_context;
+};
+
+// Wraps `f` to run in the current runtime context, wherever it is called: `pool.submit(bind_context(task))`
+template<typename F>
+context_task<std::decay_t<F>> bind_context(F&& f)
+{
+    return context_task<std::decay_t<F>>(std::forward<F>(f));
+}
+
 }  // namespace wwa::opentelemetry
 
 #endif /* B9313F7F_096F_47E8_9AAA_B3828659B876 */
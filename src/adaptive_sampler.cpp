@@ -0,0 +1,144 @@
+#include "adaptive_sampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <format>
+
+#include "queue_stats.h"
+
+namespace {
+
+constexpr std::int64_t update_interval = 1'000'000'000;  // nanoseconds
+constexpr double min_probability       = 1.0 / (1U << 20U);
+constexpr double max_decrease          = 0.25;
+constexpr double max_increase          = 1.25;
+constexpr double pressure_decrease     = 0.5;
+constexpr double high_watermark        = 0.5;
+
+std::int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+// W3C Trace Context Level 2: the rightmost 7 bytes of the trace ID are random
+constexpr unsigned int random_bits   = 56;
+constexpr std::uint64_t random_range = std::uint64_t{1} << random_bits;
+
+/**
+ * Returns how many of the 2^56 values of the random part of the trace ID are sampled, like the thresholds of
+ * the OpenTelemetry consistent probability sampling (which counts the rejected values instead).
+ */
+std::uint64_t to_threshold(double probability) noexcept
+{
+    if (probability >= 1.0) {
+        return random_range;
+    }
+
+    return static_cast<std::uint64_t>(probability * static_cast<double>(random_range));
+}
+
+std::uint64_t get_random_part(opentelemetry::trace::TraceId trace_id) noexcept
+{
+    const auto bytes    = trace_id.Id();
+    std::uint64_t value = 0;
+    for (std::size_t i = bytes.size() - random_bits / 8U; i < bytes.size(); ++i) {
+        value = (value << 8U) | bytes[i];  // NOLINT(*-magic-numbers)
+    }
+
+    return value;
+}
+
+std::uint64_t delta(std::uint64_t current, std::uint64_t previous) noexcept
+{
+    // Counters go backwards when a processor goes away
+    return current > previous ? current - previous : 0;
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+adaptive_sampler::adaptive_sampler(double target)
+    : m_target(target), m_description(std::format("AdaptiveSampler{{{:f}}}", target)),
+      m_threshold(to_threshold(1.0)), m_next_update(now() + update_interval), m_last_update(now())
+{
+}
+
+::opentelemetry::sdk::trace::SamplingResult adaptive_sampler::ShouldSample(
+    const ::opentelemetry::trace::SpanContext& parent_context, ::opentelemetry::trace::TraceId trace_id,
+    ::opentelemetry::nostd::string_view, ::opentelemetry::trace::SpanKind,
+    const ::opentelemetry::common::KeyValueIterable&, const ::opentelemetry::trace::SpanContextKeyValueIterable&
+) noexcept
+{
+    using ::opentelemetry::sdk::trace::Decision;
+
+    if (const auto current = now(); current >= this->m_next_update.load(std::memory_order_relaxed)) {
+        this->update(current);
+    }
+
+    if (get_random_part(trace_id) < this->m_threshold.load(std::memory_order_relaxed)) {
+        return {Decision::RECORD_AND_SAMPLE, nullptr, parent_context.trace_state()};
+    }
+
+    return {Decision::DROP, nullptr, parent_context.trace_state()};
+}
+
+::opentelemetry::nostd::string_view adaptive_sampler::GetDescription() const noexcept
+{
+    return this->m_description;
+}
+
+void adaptive_sampler::update(std::int64_t now) noexcept
+{
+    // Whoever gets the lock first updates the probability; everybody else keeps sampling with the current one
+    const std::unique_lock lock(this->m_mutex, std::try_to_lock);
+    if (!lock.owns_lock() || now < this->m_next_update.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    this->m_next_update.store(now + update_interval, std::memory_order_relaxed);
+
+    std::uint64_t enqueued = 0;
+    std::uint64_t dropped  = 0;
+    double fill            = 0.0;
+    try {
+        for (const auto& stats : get_queue_stats()) {
+            if (stats->signal != "traces") {
+                continue;
+            }
+
+            enqueued += stats->enqueued.load();
+            dropped += stats->dropped.load();
+            if (stats->capacity != 0) {
+                fill = std::max(fill, static_cast<double>(stats->pending()) / static_cast<double>(stats->capacity));
+            }
+        }
+    }
+    catch (const std::exception&) {
+        // Out of memory: keep the current probability
+        return;
+    }
+
+    const auto new_spans     = delta(enqueued, this->m_last_enqueued);
+    const auto dropped_spans = delta(dropped, this->m_last_dropped);
+    const auto elapsed       = static_cast<double>(now - this->m_last_update) / static_cast<double>(update_interval);
+
+    this->m_last_enqueued = enqueued;
+    this->m_last_dropped  = dropped;
+    this->m_last_update   = now;
+
+    // Offered load: spans that made it into the queues plus spans that did not fit
+    const auto rate = elapsed > 0.0 ? static_cast<double>(new_spans + dropped_spans) / elapsed : 0.0;
+    auto factor     = rate > 0.0 ? this->m_target / rate : max_increase;
+    if (dropped_spans > 0 || fill > high_watermark) {
+        factor = std::min(factor, pressure_decrease);
+    }
+
+    factor              = std::clamp(factor, max_decrease, max_increase);
+    this->m_probability = std::clamp(this->m_probability * factor, min_probability, 1.0);
+    this->m_threshold.store(to_threshold(this->m_probability), std::memory_order_relaxed);
+}
+
+}  // namespace wwa::opentelemetry
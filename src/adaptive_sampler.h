@@ -0,0 +1,52 @@
+#ifndef B8D4F2A7_1C9E_4B63_8E5A_0D7C3F6B2A91
+#define B8D4F2A7_1C9E_4B63_8E5A_0D7C3F6B2A91
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+#include <opentelemetry/sdk/trace/sampler.h>
+
+namespace wwa::opentelemetry {
+
+/**
+ * Samples traces with a probability that follows the load of the span processors created by this library.
+ *
+ * Once per second, the sampler compares the rate at which spans enter the processor queues with `target`
+ * (spans per second) and looks at how full the queues are and whether they dropped anything; the probability is
+ * then scaled towards the target, halved under pressure, and raised at most by a quarter per second.
+ * The decision is made on the trace ID, like TraceIdRatioBased does, so that whole traces are kept or shed.
+ */
+class adaptive_sampler : public ::opentelemetry::sdk::trace::Sampler {
+public:
+    explicit adaptive_sampler(double target);
+
+    ::opentelemetry::sdk::trace::SamplingResult ShouldSample(
+        const ::opentelemetry::trace::SpanContext& parent_context, ::opentelemetry::trace::TraceId trace_id,
+        ::opentelemetry::nostd::string_view name, ::opentelemetry::trace::SpanKind span_kind,
+        const ::opentelemetry::common::KeyValueIterable& attributes,
+        const ::opentelemetry::trace::SpanContextKeyValueIterable& links
+    ) noexcept override;
+
+    [[nodiscard]] ::opentelemetry::nostd::string_view GetDescription() const noexcept override;
+
+private:
+    double m_target;
+    std::string m_description;
+    std::atomic<std::uint64_t> m_threshold;
+    std::atomic<std::int64_t> m_next_update;
+
+    // Updater state, guarded by m_mutex
+    std::mutex m_mutex;
+    double m_probability = 1.0;
+    std::int64_t m_last_update;
+    std::uint64_t m_last_enqueued = 0;
+    std::uint64_t m_last_dropped  = 0;
+
+    void update(std::int64_t now) noexcept;
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* B8D4F2A7_1C9E_4B63_8E5A_0D7C3F6B2A91 */
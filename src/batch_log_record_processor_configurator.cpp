@@ -1,58 +1,48 @@
-#include <chrono>
+#include <memory>
 #include <utility>
+#include <vector>
 
 #include <opentelemetry/sdk/logs/batch_log_record_processor_factory.h>
 #include <opentelemetry/sdk/logs/batch_log_record_processor_options.h>
 #include <opentelemetry/sdk/logs/exporter.h>
 #include <opentelemetry/sdk/logs/processor.h>
 
+#include "batching.h"
 #include "configurator_p.h"
-#include "helpers.h"
+#include "export_scheduler.h"
+#include "instrumented_exporter.h"
+#include "opentelemetry/configurator/wwa/environment.h"
+#include "queue_stats.h"
+#include "sharded_processor.h"
 
-namespace {
+namespace wwa::opentelemetry {
 
-opentelemetry::sdk::logs::BatchLogRecordProcessorOptions get_batch_log_record_processor_options()
+log_record_processor_t
+get_batch_log_record_processor(std::vector<log_record_exporter_t>&& exporters, const environment_t& env)
 {
-    using wwa::opentelemetry::helpers::get_env_long;
-    opentelemetry::sdk::logs::BatchLogRecordProcessorOptions options;
-
-    // OTEL_BLRP_EXPORT_TIMEOUT: Maximum allowed time (in milliseconds) to export data (30000): does not seem to be supported
-
-    constexpr auto default_delay                 = 5000UL;
-    constexpr auto default_max_queue_size        = 2048UL;
-    constexpr auto default_max_export_batch_size = 512UL;
+    auto scheduler = get_export_scheduler(env);
+    auto options   = make_batching_options(env.blrp);
 
-    options.schedule_delay_millis = std::chrono::milliseconds(get_env_long("OTEL_BLRP_SCHEDULE_DELAY", default_delay));
-    options.max_queue_size        = get_env_long("OTEL_BLRP_MAX_QUEUE_SIZE", default_max_queue_size);
-    options.max_export_batch_size = get_env_long("OTEL_BLRP_MAX_EXPORT_BATCH_SIZE", default_max_export_batch_size);
+    // BatchLogRecordProcessor supports neither the shared scheduler nor the extra options:
+    // use the sharded processor
+    if (env.blrp.impl != "batch" || scheduler || needs_library_processor(options)) {
+        if (env.self_telemetry) {
+            options.stats = make_queue_stats("logs", get_exporter_name(*exporters.front()), env.blrp.max_queue_size);
+        }
 
-    if (options.max_export_batch_size > options.max_queue_size) {
-        INTERNAL_LOG_WARN(
-            "OTEL_BLRP_MAX_EXPORT_BATCH_SIZE is greater than OTEL_BLRP_MAX_QUEUE_SIZE. Using OTEL_BLRP_MAX_QUEUE_SIZE "
-            "as the batch size."
-        );
-
-        options.max_export_batch_size = options.max_queue_size;
+        return std::make_unique<sharded_log_record_processor>(std::move(exporters), options, std::move(scheduler));
     }
 
-    return options;
-}
-
-}  // namespace
-
-namespace wwa::opentelemetry {
-
-log_record_processor_t get_batch_log_record_processor(log_record_exporter_t&& exporter)
-{
-    static bool initialized = false;
-    static ::opentelemetry::sdk::logs::BatchLogRecordProcessorOptions options;
-
-    if (!initialized) {
-        options     = get_batch_log_record_processor_options();
-        initialized = true;
-    }
+    // Self-telemetry only sees the exporter side of BatchLogRecordProcessor
+    ::opentelemetry::sdk::logs::BatchLogRecordProcessorOptions sdk_options;
+    sdk_options.schedule_delay_millis = env.blrp.schedule_delay;
+    sdk_options.max_queue_size        = env.blrp.max_queue_size;
+    sdk_options.max_export_batch_size = env.blrp.max_export_batch_size;
 
-    return ::opentelemetry::sdk::logs::BatchLogRecordProcessorFactory::Create(std::move(exporter), options);
+    // Only one export at a time: there is only one instance
+    return ::opentelemetry::sdk::logs::BatchLogRecordProcessorFactory::Create(
+        std::move(exporters.front()), sdk_options
+    );
 }
 
 }  // namespace wwa::opentelemetry
@@ -1,57 +1,50 @@
-#include <chrono>
+#include <memory>
 #include <utility>
+#include <vector>
 
-#include <opentelemetry/sdk/common/global_log_handler.h>
 #include <opentelemetry/sdk/trace/batch_span_processor_factory.h>
 #include <opentelemetry/sdk/trace/batch_span_processor_options.h>
 
+#include "batching.h"
 #include "configurator_p.h"
-#include "helpers.h"
+#include "export_scheduler.h"
+#include "instrumented_exporter.h"
+#include "opentelemetry/configurator/wwa/environment.h"
+#include "queue_stats.h"
+#include "ring_span_processor.h"
+#include "sharded_processor.h"
 
-namespace {
+namespace wwa::opentelemetry {
 
-opentelemetry::sdk::trace::BatchSpanProcessorOptions get_batch_span_processor_options()
+span_processor_t get_batch_span_processor(std::vector<span_exporter_t>&& exporters, const environment_t& env)
 {
-    using wwa::opentelemetry::helpers::get_env_long;
-    opentelemetry::sdk::trace::BatchSpanProcessorOptions options;
-
-    // OTEL_BSP_EXPORT_TIMEOUT: Maximum allowed time (in milliseconds) to export data (30000): does not seem to be supported
-
-    constexpr auto default_delay                 = 5000UL;
-    constexpr auto default_max_queue_size        = 2048UL;
-    constexpr auto default_max_export_batch_size = 512UL;
-
-    options.schedule_delay_millis = std::chrono::milliseconds(get_env_long("OTEL_BSP_SCHEDULE_DELAY", default_delay));
-    options.max_queue_size        = get_env_long("OTEL_BSP_MAX_QUEUE_SIZE", default_max_queue_size);
-    options.max_export_batch_size = get_env_long("OTEL_BSP_MAX_EXPORT_BATCH_SIZE", default_max_export_batch_size);
-
-    if (options.max_export_batch_size > options.max_queue_size) {
-        INTERNAL_LOG_WARN(
-            "OTEL_BSP_MAX_EXPORT_BATCH_SIZE is greater than OTEL_BSP_MAX_QUEUE_SIZE. Using OTEL_BSP_MAX_QUEUE_SIZE as "
-            "the batch size."
+    auto scheduler = get_export_scheduler(env);
+    auto options   = make_batching_options(env.bsp);
+
+    // The adaptive sampler reads the queue counters, which only the processors of this library keep
+    const bool adaptive = env.traces_sampler == "adaptive";
+    if (env.bsp.impl == "batch" && !scheduler && !needs_library_processor(options) && !adaptive) {
+        // Self-telemetry only sees the exporter side of BatchSpanProcessor
+        ::opentelemetry::sdk::trace::BatchSpanProcessorOptions sdk_options;
+        sdk_options.schedule_delay_millis = env.bsp.schedule_delay;
+        sdk_options.max_queue_size        = env.bsp.max_queue_size;
+        sdk_options.max_export_batch_size = env.bsp.max_export_batch_size;
+        // Only one export at a time: there is only one instance
+        return ::opentelemetry::sdk::trace::BatchSpanProcessorFactory::Create(
+            std::move(exporters.front()), sdk_options
         );
-
-        options.max_export_batch_size = options.max_queue_size;
     }
 
-    return options;
-}
-
-}  // namespace
-
-namespace wwa::opentelemetry {
-
-span_processor_t get_batch_span_processor(span_exporter_t&& exporter)
-{
-    static bool initialized = false;
-    static ::opentelemetry::sdk::trace::BatchSpanProcessorOptions options;
+    if (env.self_telemetry || adaptive) {
+        options.stats = make_queue_stats("traces", get_exporter_name(*exporters.front()), env.bsp.max_queue_size);
+    }
 
-    if (!initialized) {
-        options     = get_batch_span_processor_options();
-        initialized = true;
+    // BatchSpanProcessor supports neither the shared scheduler nor the extra options
+    if (env.bsp.impl == "ring") {
+        return std::make_unique<ring_span_processor>(std::move(exporters), options, std::move(scheduler));
     }
 
-    return ::opentelemetry::sdk::trace::BatchSpanProcessorFactory::Create(std::move(exporter), options);
+    return std::make_unique<sharded_span_processor>(std::move(exporters), options, std::move(scheduler));
 }
 
 }  // namespace wwa::opentelemetry
@@ -0,0 +1,169 @@
+#include "batching.h"
+
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#include "configurator_p.h"
+
+namespace wwa::opentelemetry {
+
+batching_options_t make_batching_options(const batch_processor_environment_t& env)
+{
+    batching_options_t options;
+    options.schedule_delay         = env.schedule_delay;
+    options.max_queue_size         = env.max_queue_size;
+    options.max_export_batch_size  = env.max_export_batch_size;
+    options.max_queue_bytes        = env.max_queue_bytes;
+    options.max_export_batch_bytes = env.max_export_batch_bytes;
+    options.export_timeout         = env.export_timeout;
+    options.max_concurrent_exports = env.max_concurrent_exports;
+    return options;
+}
+
+void log_batching_warning(std::string_view message) noexcept
+{
+    try {
+        INTERNAL_LOG_WARN(std::string(message));
+    }
+    catch (...) {  // NOLINT(bugprone-empty-catch)
+    }
+}
+
+std::size_t get_thread_slot() noexcept
+{
+    static std::atomic<std::size_t> next_slot{0};
+    thread_local const std::size_t slot = next_slot.fetch_add(1, std::memory_order_relaxed);
+    return slot;
+}
+
+batch_worker::batch_worker(
+    std::chrono::milliseconds schedule_delay, std::function<bool(bool)> export_cycle,
+    std::shared_ptr<export_scheduler> scheduler
+)
+    : m_schedule_delay(schedule_delay), m_export_cycle(std::move(export_cycle)), m_scheduler(std::move(scheduler))
+{
+}
+
+batch_worker::~batch_worker()
+{
+    this->stop();
+}
+
+void batch_worker::start()
+{
+    if (this->m_scheduler) {
+        this->m_task = this->m_scheduler->schedule([this]() { this->cycle(); }, this->m_schedule_delay);
+    }
+    else {
+        this->m_thread = std::thread(&batch_worker::run, this);
+    }
+}
+
+void batch_worker::notify() noexcept
+{
+    if (!this->m_notified.load(std::memory_order_relaxed) && !this->m_notified.exchange(true)) {
+        this->wake();
+    }
+}
+
+bool batch_worker::force_flush(std::chrono::microseconds timeout) noexcept
+{
+    if (this->is_stopped()) {
+        return false;
+    }
+
+    const auto ticket = this->m_flush_requested.fetch_add(1) + 1;
+    this->wake();
+
+    try {
+        std::unique_lock lock(this->m_mutex);
+        return wait_for(this->m_flush_cv, lock, timeout, [this, ticket]() {
+            return this->m_flush_completed >= ticket;
+        });
+    }
+    catch (const std::system_error&) {
+        return false;
+    }
+}
+
+bool batch_worker::stop() noexcept
+{
+    if (this->m_is_stopped.exchange(true)) {
+        return false;
+    }
+
+    if (this->m_scheduler) {
+        // Waits for a running cycle to complete; the last cycle drains whatever is left
+        this->m_scheduler->cancel(this->m_task);
+        this->cycle();
+    }
+    else {
+        this->wake();
+        if (this->m_thread.joinable()) {
+            this->m_thread.join();
+        }
+    }
+
+    return true;
+}
+
+void batch_worker::wake() noexcept
+{
+    if (this->m_scheduler) {
+        this->m_scheduler->trigger(this->m_task);
+        return;
+    }
+
+    try {
+        const std::lock_guard lock(this->m_mutex);
+    }
+    catch (const std::system_error&) {  // NOLINT(bugprone-empty-catch)
+        // The notification below may get lost; the worker wakes up after schedule_delay anyway
+    }
+
+    this->m_cv.notify_one();
+}
+
+void batch_worker::run()
+{
+    while (true) {
+        {
+            std::unique_lock lock(this->m_mutex);
+            this->m_cv.wait_for(lock, this->m_schedule_delay, [this]() {
+                return this->m_notified.load(std::memory_order_acquire) || this->is_stopped() ||
+                       this->m_flush_requested.load(std::memory_order_acquire) != this->m_flush_completed;
+            });
+        }
+
+        const bool is_stopped = this->is_stopped();
+
+        // On shutdown, this drains whatever is left in the queue
+        this->cycle();
+        if (is_stopped) {
+            break;
+        }
+    }
+}
+
+void batch_worker::cycle()
+{
+    // Everything enqueued before these flush requests is exported by this cycle
+    const auto flush = this->m_flush_requested.load(std::memory_order_acquire);
+    this->m_notified.store(false, std::memory_order_release);
+
+    // Only the last cycle may block the shared scheduler: nothing would resume its leftovers
+    if (!this->m_export_cycle(!this->m_scheduler || this->is_stopped())) {
+        return;
+    }
+
+    {
+        const std::lock_guard lock(this->m_mutex);
+        this->m_flush_completed = flush;
+    }
+
+    this->m_flush_cv.notify_all();
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,130 @@
+#ifndef F3A8C6D1_2B9E_4F47_8C3A_5E0D9B7F1A62
+#define F3A8C6D1_2B9E_4F47_8C3A_5E0D9B7F1A62
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "export_scheduler.h"
+#include "opentelemetry/configurator/wwa/environment.h"
+
+namespace wwa::opentelemetry {
+
+struct queue_stats_t;
+
+// The knobs shared by the batching processors implemented by this library; see OTEL_BSP_* and OTEL_BLRP_*
+struct batching_options_t {
+    std::size_t max_queue_size = 2048;
+    std::chrono::milliseconds schedule_delay{5000};
+    std::size_t max_export_batch_size = 512;
+    // Limits on the estimated size of the queued items; zero means no limit
+    std::size_t max_queue_bytes        = 0;
+    std::size_t max_export_batch_bytes = 0;
+    // When unset, and only one export may be in flight, the worker exports the batches itself
+    std::optional<std::chrono::milliseconds> export_timeout;
+    std::size_t max_concurrent_exports = 1;
+    // Set when self-telemetry or the adaptive sampler needs the queue counters
+    std::shared_ptr<queue_stats_t> stats;
+};
+
+batching_options_t make_batching_options(const batch_processor_environment_t& env);
+// Does not throw, not even when the message cannot be allocated, so it is safe to call from noexcept code
+void log_batching_warning(std::string_view message) noexcept;
+
+// Small integer assigned to the calling thread on first use; consecutive threads get consecutive slots
+std::size_t get_thread_slot() noexcept;
+
+[[nodiscard]] constexpr bool is_byte_limited(const batching_options_t& options) noexcept
+{
+    return options.max_queue_bytes != 0 || options.max_export_batch_bytes != 0;
+}
+
+// Whether the options need one of the processors of this library: the SDK batch processors support none of these
+[[nodiscard]] constexpr bool needs_library_processor(const batching_options_t& options) noexcept
+{
+    return is_byte_limited(options) || options.export_timeout.has_value() || options.max_concurrent_exports > 1;
+}
+
+/**
+ * `condition_variable::wait_for()` overflows with `microseconds::max()`, which is the default timeout
+ * of `ForceFlush()` and `Shutdown()`.
+ */
+template<typename Predicate>
+bool wait_for(
+    std::condition_variable& cv, std::unique_lock<std::mutex>& lock, std::chrono::microseconds timeout,
+    Predicate predicate
+)
+{
+    if (timeout == std::chrono::microseconds::max()) {
+        cv.wait(lock, predicate);
+        return true;
+    }
+
+    return cv.wait_for(lock, timeout, predicate);
+}
+
+/**
+ * Drives the export cycles of a batching processor: calls `export_cycle` every `schedule_delay`, early after
+ * `notify()`, on `force_flush()`, and one last time on `stop()`.
+ *
+ * The cycles run on a dedicated thread, or on the shared export scheduler when one is given. `export_cycle(block)`
+ * may wait for a free export slot only if `block` is set; it is not set on the shared scheduler, whose threads
+ * serve every processor. A cycle that returns false has left work behind: the processor resumes it in a later cycle
+ * (calling `notify()` once a slot is free), and pending flushes complete only when a cycle returns true.
+ */
+class batch_worker {
+public:
+    batch_worker(
+        std::chrono::milliseconds schedule_delay, std::function<bool(bool)> export_cycle,
+        std::shared_ptr<export_scheduler> scheduler
+    );
+
+    batch_worker(const batch_worker&)            = delete;
+    batch_worker& operator=(const batch_worker&) = delete;
+    batch_worker(batch_worker&&)                 = delete;
+    batch_worker& operator=(batch_worker&&)      = delete;
+    ~batch_worker();
+
+    // Must be called once the owner is fully constructed
+    void start();
+
+    // Starts an export cycle early; only the first call per cycle does any work
+    void notify() noexcept;
+    bool force_flush(std::chrono::microseconds timeout) noexcept;
+    // Returns false if the worker has already been stopped
+    bool stop() noexcept;
+
+    [[nodiscard]] bool is_stopped() const noexcept { return this->m_is_stopped.load(std::memory_order_acquire); }
+
+private:
+    std::chrono::milliseconds m_schedule_delay;
+    std::function<bool(bool)> m_export_cycle;
+    std::shared_ptr<export_scheduler> m_scheduler;
+    export_scheduler::task_id_t m_task = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_flush_cv;
+    std::atomic<bool> m_notified{false};
+    std::atomic<bool> m_is_stopped{false};
+    std::atomic<std::uint64_t> m_flush_requested{0};
+    std::uint64_t m_flush_completed = 0;  // Guarded by m_mutex
+    std::thread m_thread;
+
+    void wake() noexcept;
+    void run();
+    void cycle();
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* F3A8C6D1_2B9E_4F47_8C3A_5E0D9B7F1A62 */
@@ -0,0 +1,123 @@
+#ifndef A6C3E9B2_5D8F_4A17_9B4C_3E1F7D0A8C65
+#define A6C3E9B2_5D8F_4A17_9B4C_3E1F7D0A8C65
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace wwa::opentelemetry {
+
+// Not std::hardware_destructive_interference_size: not every standard library provides it
+constexpr std::size_t cache_line_size = 64;
+
+/**
+ * Bounded lock-free queue of owned objects (Dmitry Vyukov's bounded MPMC queue), used with many producers
+ * and a single consumer.
+ *
+ * Each slot carries a sequence number that tells producers and the consumer whose turn it is, so that
+ * a successful `push()` is one compare-and-swap on the head plus a store into a slot nobody else touches.
+ * Slots are padded to a cache line so that producers writing to adjacent slots do not contend.
+ */
+template<typename T>
+class bounded_queue {
+public:
+    explicit bounded_queue(std::size_t capacity) : m_cells(capacity), m_capacity(capacity)
+    {
+        for (std::size_t i = 0; i < capacity; ++i) {
+            this->m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bounded_queue(const bounded_queue&)            = delete;
+    bounded_queue& operator=(const bounded_queue&) = delete;
+    bounded_queue(bounded_queue&&)                 = delete;
+    bounded_queue& operator=(bounded_queue&&)      = delete;
+
+    ~bounded_queue()
+    {
+        while (this->pop()) {
+        }
+    }
+
+    /**
+     * Thread-safe. Returns false, leaving `item` untouched, if the queue is full.
+     */
+    bool push(std::unique_ptr<T>& item) noexcept
+    {
+        if (this->m_capacity == 0) {
+            return false;
+        }
+
+        auto pos = this->m_head.load(std::memory_order_relaxed);
+        cell_t* cell;  // NOLINT(cppcoreguidelines-init-variables)
+        while (true) {
+            cell            = &this->m_cells[pos % this->m_capacity];
+            const auto seq  = cell->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (this->m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            }
+            else if (diff < 0) {
+                return false;
+            }
+            else {
+                pos = this->m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = item.release();
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Must only be called by one thread at a time. Returns nullptr if the queue is empty.
+     */
+    std::unique_ptr<T> pop() noexcept
+    {
+        if (this->m_capacity == 0) {
+            return nullptr;
+        }
+
+        const auto pos = this->m_tail.load(std::memory_order_relaxed);
+        auto& cell     = this->m_cells[pos % this->m_capacity];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1) {
+            return nullptr;
+        }
+
+        std::unique_ptr<T> item(cell.data);
+        cell.data = nullptr;
+        cell.sequence.store(pos + this->m_capacity, std::memory_order_release);
+        this->m_tail.store(pos + 1, std::memory_order_relaxed);
+        return item;
+    }
+
+    // Approximate when called concurrently with push() or pop()
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        const auto tail = this->m_tail.load(std::memory_order_relaxed);
+        const auto head = this->m_head.load(std::memory_order_relaxed);
+        return head > tail ? head - tail : 0;
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return this->m_capacity; }
+
+private:
+    struct alignas(cache_line_size) cell_t {
+        std::atomic<std::size_t> sequence{0};
+        T* data = nullptr;
+    };
+
+    std::vector<cell_t> m_cells;
+    std::size_t m_capacity;
+    alignas(cache_line_size) std::atomic<std::size_t> m_head{0};
+    alignas(cache_line_size) std::atomic<std::size_t> m_tail{0};
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* A6C3E9B2_5D8F_4A17_9B4C_3E1F7D0A8C65 */
@@ -1,5 +1,7 @@
 #include "opentelemetry/configurator/wwa/configurator.h"
 
+#include <atomic>
+#include <future>
 #include <utility>
 #include <variant>
 
@@ -11,67 +13,146 @@
 #include <opentelemetry/trace/provider.h>
 #include <opentelemetry/trace/tracer_provider.h>
 
-#include "helpers.h"
+#include "configurator_p.h"
+#include "opentelemetry/configurator/wwa/environment.h"
+#include "opentelemetry/configurator/wwa/utils.h"
+
+namespace {
+
+using namespace wwa::opentelemetry;
+
+tracer_provider_t
+build_tracer_provider(
+    opentelemetry_configuration_t& opts, const ::opentelemetry::sdk::resource::Resource& resource,
+    const environment_t& env
+)
+{
+    tracer_provider_config_t tracer_provider_config;
+    tracer_provider_config.configure_exporters = true;
+    tracer_provider_config.resource            = resource;
+    tracer_provider_config.span_exporter_config =
+        std::move(opts.span_exporter_config);  // NOLINT(performance-move-const-arg)
+    tracer_provider_config.processors      = std::move(opts.span_processors);
+    tracer_provider_config.tracing_sampler = std::move(opts.tracing_sampler);
+    tracer_provider_config.id_generator    = std::move(opts.id_generator);
+    return configure_tracer_provider(std::move(tracer_provider_config), env);
+}
+
+meter_provider_t
+build_meter_provider(
+    opentelemetry_configuration_t& opts, const ::opentelemetry::sdk::resource::Resource& resource,
+    const environment_t& env
+)
+{
+    meter_provider_config_t meter_provider_config;
+    meter_provider_config.configure_exporters = true;
+    meter_provider_config.metric_exporter_config =
+        std::move(opts.metric_exporter_config);  // NOLINT(performance-move-const-arg)
+    meter_provider_config.view_registry = std::move(opts.view_registry);
+    meter_provider_config.resource      = resource;
+    return configure_meter_provider(std::move(meter_provider_config), env);
+}
+
+logger_provider_t
+build_logger_provider(
+    opentelemetry_configuration_t& opts, const ::opentelemetry::sdk::resource::Resource& resource,
+    const environment_t& env
+)
+{
+    logger_provider_config_t logger_provider_config;
+    logger_provider_config.configure_exporters = true;
+    logger_provider_config.log_record_exporter_config =
+        std::move(opts.log_record_exporter_config);  // NOLINT(performance-move-const-arg)
+    logger_provider_config.processors = std::move(opts.log_processors);
+    logger_provider_config.resource   = resource;
+    return configure_logger_provider(std::move(logger_provider_config), env);
+}
+
+}  // namespace
 
 namespace wwa::opentelemetry {
 
 void configure_opentelemetry(opentelemetry_configuration_t&& opts)
 {
-    if (helpers::get_env_bool("OTEL_SDK_DISABLED")) {
+    // The snapshot is kept alive until the configuration is complete
+    const auto env = get_process_environment();
+    configure_opentelemetry(std::move(opts), *env);
+}
+
+void configure_opentelemetry(opentelemetry_configuration_t&& opts, const environment_t& env)
+{
+    tracing_enabled.store(!env.sdk_disabled, std::memory_order_relaxed);
+    if (env.sdk_disabled) {
         return;
     }
 
-    // 1. Configure internal logging
-    configure_internal_logging_from_environment();
+    // 1. Configure internal logging and report the problems found in the environment, skipping disabled signals
+    configure_internal_logging_from_environment(env);
+    for (const auto& [exporters, scope] : {
+             std::pair{&env.traces_exporters, environment_scope_t::traces},
+             std::pair{&env.metrics_exporters, environment_scope_t::metrics},
+             std::pair{&env.logs_exporters, environment_scope_t::logs},
+         }) {
+        if (!exporters->empty()) {
+            report_environment_warnings_once(env, scope);
+        }
+    }
 
     // 2. Configure Resource, as it will be used by all providers
     auto resource = std::holds_alternative<resource_config_t>(opts.resource)
                         ? configure_resource(std::get<resource_config_t>(opts.resource))
                         : std::get<::opentelemetry::sdk::resource::Resource>(opts.resource);
 
-    // 3. Configure TracerProvider
-    tracer_provider_config_t tracer_provider_config;
-    tracer_provider_config.configure_exporters = true;
-    tracer_provider_config.resource            = resource;
-    tracer_provider_config.span_exporter_config =
-        std::move(opts.span_exporter_config);  // NOLINT(performance-move-const-arg)
-    tracer_provider_config.processors      = std::move(opts.span_processors);
-    tracer_provider_config.tracing_sampler = std::move(opts.tracing_sampler);
-    tracer_provider_config.id_generator    = std::move(opts.id_generator);
-    auto tracer_provider                   = configure_tracer_provider(std::move(tracer_provider_config));
+    // 3. Build TracerProvider, MeterProvider, and LoggerProvider
+    tracer_provider_t tracer_provider;
+    meter_provider_t meter_provider;
+    logger_provider_t logger_provider;
+
+    if (opts.concurrent_initialization) {
+        // The state the builders share (the export scheduler, the queue_stats and self-telemetry registries, and
+        // the process environment snapshot) is guarded by mutexes; `env` and `resource` are only read, and each
+        // builder only moves its own members out of `opts`
+        auto tracer_future =
+            std::async(std::launch::async, [&opts, &resource, &env]() {
+                return build_tracer_provider(opts, resource, env);
+            });
+        auto meter_future =
+            std::async(std::launch::async, [&opts, &resource, &env]() {
+                return build_meter_provider(opts, resource, env);
+            });
+
+        logger_provider = build_logger_provider(opts, resource, env);
+        tracer_provider = tracer_future.get();
+        meter_provider  = meter_future.get();
+    }
+    else {
+        tracer_provider = build_tracer_provider(opts, resource, env);
+        meter_provider  = build_meter_provider(opts, resource, env);
+        logger_provider = build_logger_provider(opts, resource, env);
+    }
+
+    // 4. Install TracerProvider
     auto api_tracer_provider =
         ::opentelemetry::nostd::shared_ptr<::opentelemetry::trace::TracerProvider>(tracer_provider.release());
     ::opentelemetry::trace::Provider::SetTracerProvider(api_tracer_provider);
 
-    // 4. Configure Propagator
+    // 5. Configure Propagator
     auto propagator = std::holds_alternative<propagator_config_t>(opts.propagator)
-                          ? configure_propagators_from_environment(std::get<propagator_config_t>(opts.propagator))
+                          ? configure_propagators_from_environment(std::get<propagator_config_t>(opts.propagator), env)
                           : std::get<propagator_t>(opts.propagator);
     ::opentelemetry::context::propagation::GlobalTextMapPropagator::SetGlobalPropagator(propagator);
 
-    // 5. Configure MeterProvider
-    meter_provider_config_t meter_provider_config;
-    meter_provider_config.configure_exporters = true;
-    meter_provider_config.metric_exporter_config =
-        std::move(opts.metric_exporter_config);  // NOLINT(performance-move-const-arg)
-    meter_provider_config.view_registry = std::move(opts.view_registry);
-    meter_provider_config.resource      = resource;
-    auto meter_provider                 = configure_meter_provider(std::move(meter_provider_config));
+    // 6. Install MeterProvider
     auto api_meter_provider =
         ::opentelemetry::nostd::shared_ptr<::opentelemetry::metrics::MeterProvider>(meter_provider.release());
     ::opentelemetry::metrics::Provider::SetMeterProvider(api_meter_provider);
 
-    // 6. Configure LoggerProvider
-    logger_provider_config_t logger_provider_config;
-    logger_provider_config.configure_exporters = true;
-    logger_provider_config.log_record_exporter_config =
-        std::move(opts.log_record_exporter_config);  // NOLINT(performance-move-const-arg)
-    logger_provider_config.processors = std::move(opts.log_processors);
-    logger_provider_config.resource   = resource;
-    auto logger_provider              = configure_logger_provider(std::move(logger_provider_config));
+    // 7. Install LoggerProvider
     auto api_logger_provider =
         ::opentelemetry::nostd::shared_ptr<::opentelemetry::logs::LoggerProvider>(logger_provider.release());
     ::opentelemetry::logs::Provider::SetLoggerProvider(api_logger_provider);
+
+    invalidate_cached_handles();
 }
 
 }  // namespace wwa::opentelemetry
@@ -2,9 +2,14 @@
 #define BFF437AD_B2D8_4090_B82F_84107BA5ED65
 
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <opentelemetry/sdk/common/attribute_utils.h>
 #include <opentelemetry/sdk/metrics/metric_reader.h>
@@ -16,10 +21,34 @@ namespace wwa::opentelemetry {
 using metric_reader_t  = std::unique_ptr<::opentelemetry::sdk::metrics::MetricReader>;
 using span_processor_t = std::unique_ptr<::opentelemetry::sdk::trace::SpanProcessor>;
 
-log_record_processor_t get_batch_log_record_processor(log_record_exporter_t&& exporter);
-span_processor_t get_batch_span_processor(span_exporter_t&& exporter);
-id_generator_t get_id_generator();
-metric_reader_t get_periodic_exporting_metric_reader(metric_exporter_t&& exporter);
+std::shared_ptr<const environment_t> get_process_environment();
+// Returns the process snapshot, after reporting its common warnings and those of `scope`
+std::shared_ptr<const environment_t> get_process_environment(environment_scope_t scope);
+// Like report_environment_warnings(), but the warnings of the process snapshot are only reported once per scope
+void report_environment_warnings_once(const environment_t& env, environment_scope_t scope);
+// Only OTEL_TRACES_SAMPLER and OTEL_TRACES_SAMPLER_ARG, for reloading the sampler
+environment_t capture_sampler_environment();
+
+// Defaults for OTEL_TRACES_SAMPLER_ARG, in spans per second
+constexpr double default_ratelimiting_rate = 100.0;
+constexpr double default_adaptive_target   = 1000.0;
+
+// `exporters`: instances of the same exporter, one per export slot (see max_concurrent_exports)
+log_record_processor_t
+get_batch_log_record_processor(std::vector<log_record_exporter_t>&& exporters, const environment_t& env);
+span_processor_t get_batch_span_processor(std::vector<span_exporter_t>&& exporters, const environment_t& env);
+id_generator_t get_id_generator(const environment_t& env);
+metric_reader_t get_periodic_exporting_metric_reader(metric_exporter_t&& exporter, const environment_t& env);
+
+// Adds one instance of each of `exporters` to `instances`, which holds the instances of every exporter
+template<typename Exporter>
+void add_exporter_instances(std::vector<std::vector<Exporter>>& instances, std::vector<Exporter>&& exporters)
+{
+    instances.resize(std::max(instances.size(), exporters.size()));
+    for (std::size_t i = 0; i < exporters.size(); ++i) {
+        instances[i].push_back(std::move(exporters[i]));
+    }
+}
 
 void internal_log(
     ::opentelemetry::sdk::common::internal_log::LogLevel level, const std::string& message,
@@ -0,0 +1,644 @@
+#include "opentelemetry/configurator/wwa/environment.h"
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#    include <stdlib.h>
+#elif defined(__APPLE__)
+#    include <crt_externs.h>
+#else
+#    include <unistd.h>
+#endif
+
+#include "configurator_p.h"
+#include "helpers.h"
+
+namespace {
+
+using namespace std::literals;
+using opentelemetry::sdk::common::internal_log::LogLevel;
+using wwa::opentelemetry::batch_processor_environment_t;
+using wwa::opentelemetry::environment_t;
+using wwa::opentelemetry::metric_view_rule_t;
+
+constexpr std::array<std::pair<std::string_view, LogLevel>, 5> log_levels{
+    {{"none"sv, LogLevel::None},
+     {"error"sv, LogLevel::Error},
+     {"warning"sv, LogLevel::Warning},
+     {"info"sv, LogLevel::Info},
+     {"debug"sv, LogLevel::Debug}}
+};
+
+char** get_environ()
+{
+#if defined(_WIN32)
+    return _environ;
+#elif defined(__APPLE__)
+    return *_NSGetEnviron();
+#else
+    return environ;
+#endif
+}
+
+void scan_environment(environment_t& env, std::string_view prefix = "OTEL_")
+{
+    // NOLINTNEXTLINE(*-pointer-arithmetic)
+    for (char** p = get_environ(); p != nullptr && *p != nullptr; ++p) {
+        const std::string_view entry(*p);
+        if (!entry.starts_with(prefix)) {
+            continue;
+        }
+
+        if (const auto pos = entry.find('='); pos != std::string_view::npos) {
+            env.variables.emplace(entry.substr(0, pos), entry.substr(pos + 1));
+        }
+    }
+}
+
+LogLevel parse_log_level(environment_t& env)
+{
+    const auto log_level = env.get("OTEL_LOG_LEVEL");
+    if (log_level.empty()) {
+        return LogLevel::Info;
+    }
+
+    for (const auto& [name, value] : log_levels) {
+        if (log_level == name) {
+            return value;
+        }
+    }
+
+    env.warnings.push_back(
+        std::format("Environment variable <OTEL_LOG_LEVEL> has an unknown value <{}>, ignoring", log_level)
+    );
+
+    return LogLevel::Info;
+}
+
+std::vector<std::string> to_strings(const std::vector<std::string_view>& list)
+{
+    return {list.begin(), list.end()};
+}
+
+std::vector<std::string> parse_exporters(environment_t& env, const char* name, std::string_view disabled_message)
+{
+    const auto value = env.get(name);
+    const auto names = wwa::opentelemetry::helpers::split_and_trim(value);
+
+    if (names.size() == 1 && names[0] == "none") {
+        env.warnings.push_back(std::format("{} contains \"none\". {}", name, disabled_message));
+        return {};
+    }
+
+    if (names.empty()) {
+        env.warnings.push_back(std::format("{} is empty. Using default otlp exporter.", name));
+        return {"otlp"};
+    }
+
+    if (std::ranges::find(names, "none") != names.end()) {
+        env.warnings.push_back(
+            std::format("{} contains \"none\" along with other exporters. Using default otlp exporter.", name)
+        );
+
+        return {"otlp"};
+    }
+
+    return to_strings(names);
+}
+
+std::string parse_otlp_protocol(const environment_t& env, const char* name)
+{
+    auto value = env.get(name);
+    if (value.empty()) {
+        value = env.get("OTEL_EXPORTER_OTLP_PROTOCOL");
+    }
+
+    return value.empty() ? "http/protobuf" : value;
+}
+
+std::vector<std::string> parse_propagators(environment_t& env)
+{
+    const auto value = env.get("OTEL_PROPAGATORS");
+    const auto list  = wwa::opentelemetry::helpers::split_and_trim(value);
+    if (list.empty()) {
+        return {"tracecontext", "baggage"};
+    }
+
+    std::vector<std::string> names;
+    names.reserve(list.size());
+    for (const auto& name : list) {
+        if (std::ranges::find(names, name) == names.end()) {
+            names.emplace_back(name);
+        }
+    }
+
+    if (names.size() == 1 && names[0] == "none") {
+        return {};
+    }
+
+    if (std::ranges::find(names, "none") != names.end()) {
+        env.warnings.emplace_back(
+            "OTEL_PROPAGATORS contains <none> along with other propagators. Using default propagators."
+        );
+        return {"tracecontext", "baggage"};
+    }
+
+    return names;
+}
+
+std::optional<double> parse_sampler_arg(environment_t& env)
+{
+    // The argument is only interpreted for the built-in samplers that take one; custom samplers can read the raw value
+    const auto& sampler = env.traces_sampler;
+    const bool is_ratio = sampler == "traceidratio" || sampler == "parentbased_traceidratio";
+    const bool is_rate  = sampler == "ratelimiting" || sampler == "parentbased_ratelimiting" || sampler == "adaptive";
+    if (!is_ratio && !is_rate) {
+        return std::nullopt;
+    }
+
+    const auto value = env.get("OTEL_TRACES_SAMPLER_ARG");
+    if (value.empty()) {
+        return std::nullopt;
+    }
+
+    using wwa::opentelemetry::helpers::parse_double;
+    if (is_ratio) {
+        return parse_double("OTEL_TRACES_SAMPLER_ARG", value, 1.0, 0.0, 1.0, env.traces_warnings);
+    }
+
+    const double default_rate = sampler == "adaptive" ? wwa::opentelemetry::default_adaptive_target
+                                                      : wwa::opentelemetry::default_ratelimiting_rate;
+    return parse_double(
+        "OTEL_TRACES_SAMPLER_ARG", value, default_rate, 0.0, std::numeric_limits<double>::max(), env.traces_warnings
+    );
+}
+
+/**
+ * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/#batch-span-processor
+ * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/#batch-logrecord-processor
+ */
+batch_processor_environment_t parse_batch_processor(
+    const environment_t& env, const std::string& prefix, std::initializer_list<std::string_view> implementations,
+    std::vector<std::string>& warnings
+)
+{
+    using wwa::opentelemetry::helpers::parse_long;
+
+    batch_processor_environment_t options;
+
+    const auto delay_var      = prefix + "_SCHEDULE_DELAY";
+    const auto queue_size_var = prefix + "_MAX_QUEUE_SIZE";
+    const auto batch_size_var = prefix + "_MAX_EXPORT_BATCH_SIZE";
+
+    options.schedule_delay = std::chrono::milliseconds(
+        parse_long(delay_var, env.get(delay_var), options.schedule_delay.count(), warnings)
+    );
+    options.max_queue_size = parse_long(queue_size_var, env.get(queue_size_var), options.max_queue_size, warnings);
+    options.max_export_batch_size =
+        parse_long(batch_size_var, env.get(batch_size_var), options.max_export_batch_size, warnings);
+
+    if (options.max_export_batch_size > options.max_queue_size) {
+        warnings.push_back(std::format(
+            "{} is greater than {}. Using {} as the batch size.", batch_size_var, queue_size_var, queue_size_var
+        ));
+
+        options.max_export_batch_size = options.max_queue_size;
+    }
+
+    // <prefix>_MAX_QUEUE_BYTES, <prefix>_MAX_EXPORT_BATCH_BYTES: not in the specification
+    const auto queue_bytes_var = prefix + "_MAX_QUEUE_BYTES";
+    const auto batch_bytes_var = prefix + "_MAX_EXPORT_BATCH_BYTES";
+
+    options.max_queue_bytes        = parse_long(queue_bytes_var, env.get(queue_bytes_var), 0, warnings);
+    options.max_export_batch_bytes = parse_long(batch_bytes_var, env.get(batch_bytes_var), 0, warnings);
+
+    if (options.max_queue_bytes != 0 && options.max_export_batch_bytes > options.max_queue_bytes) {
+        warnings.push_back(std::format(
+            "{} is greater than {}. Using {} as the batch size.", batch_bytes_var, queue_bytes_var, queue_bytes_var
+        ));
+
+        options.max_export_batch_bytes = options.max_queue_bytes;
+    }
+
+    // The SDK processors do not support the export timeout; the processors of this library do
+    const auto timeout_var = prefix + "_EXPORT_TIMEOUT";
+    if (const auto timeout = env.get(timeout_var); !timeout.empty()) {
+        options.export_timeout = std::chrono::milliseconds(parse_long(timeout_var, timeout, 30'000, warnings));
+    }
+
+    // <prefix>_MAX_CONCURRENT_EXPORTS: not in the specification
+    const auto concurrency_var     = prefix + "_MAX_CONCURRENT_EXPORTS";
+    options.max_concurrent_exports = std::max<std::size_t>(
+        parse_long(concurrency_var, env.get(concurrency_var), options.max_concurrent_exports, warnings), 1
+    );
+
+    // <prefix>_IMPL: not in the specification; selects the processor implementation
+    const auto impl_var = prefix + "_IMPL";
+    if (const auto impl = env.get(impl_var); !impl.empty()) {
+        if (impl == "batch" || std::ranges::find(implementations, impl) != implementations.end()) {
+            options.impl = impl;
+        }
+        else {
+            warnings.push_back(
+                std::format("Environment variable <{}> has an unknown value <{}>, ignoring", impl_var, impl)
+            );
+        }
+    }
+
+    // <prefix>_FANOUT: not in the specification either
+    const auto fanout_var = prefix + "_FANOUT";
+    options.fanout        = wwa::opentelemetry::helpers::parse_bool(fanout_var, env.get(fanout_var), warnings);
+
+    return options;
+}
+
+/**
+ * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/#periodic-exporting-metricreader
+ */
+void parse_metric_reader(environment_t& env)
+{
+    using wwa::opentelemetry::helpers::parse_long;
+
+    env.metric_export_interval = std::chrono::milliseconds(parse_long(
+        "OTEL_METRIC_EXPORT_INTERVAL", env.get("OTEL_METRIC_EXPORT_INTERVAL"), env.metric_export_interval.count(),
+        env.metrics_warnings
+    ));
+    env.metric_export_timeout = std::chrono::milliseconds(parse_long(
+        "OTEL_METRIC_EXPORT_TIMEOUT", env.get("OTEL_METRIC_EXPORT_TIMEOUT"), env.metric_export_timeout.count(),
+        env.metrics_warnings
+    ));
+}
+
+std::string to_lower(std::string value)
+{
+    std::ranges::transform(value, value.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+/**
+ * @see https://opentelemetry.io/docs/specs/otel/protocol/exporter/#additional-environment-variable-configuration
+ */
+void parse_metrics_temporality(environment_t& env)
+{
+    // The value is case-insensitive
+    const auto value = to_lower(env.get("OTEL_EXPORTER_OTLP_METRICS_TEMPORALITY_PREFERENCE"));
+    if (value == "cumulative" || value == "delta" || value == "lowmemory") {
+        env.metrics_temporality_preference = value;
+    }
+    else if (!value.empty()) {
+        env.metrics_warnings.push_back(std::format(
+            "Environment variable <OTEL_EXPORTER_OTLP_METRICS_TEMPORALITY_PREFERENCE> has an unknown value <{}>, "
+            "using cumulative",
+            value
+        ));
+    }
+}
+
+/**
+ * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/#exemplar
+ */
+void parse_exemplar_filter(environment_t& env)
+{
+    const auto value = to_lower(env.get("OTEL_METRICS_EXEMPLAR_FILTER"));
+    if (value == "always_on" || value == "always_off" || value == "trace_based") {
+        env.metrics_exemplar_filter = value;
+    }
+    else if (!value.empty()) {
+        env.metrics_warnings.push_back(std::format(
+            "Environment variable <OTEL_METRICS_EXEMPLAR_FILTER> has an unknown value <{}>, using trace_based", value
+        ));
+    }
+}
+
+/**
+ * @see https://opentelemetry.io/docs/specs/otel/protocol/exporter/#additional-environment-variable-configuration
+ */
+void parse_histogram_aggregation(environment_t& env)
+{
+    using wwa::opentelemetry::helpers::parse_int;
+    using wwa::opentelemetry::helpers::parse_long;
+
+    if (const auto value = env.get("OTEL_EXPORTER_OTLP_METRICS_DEFAULT_HISTOGRAM_AGGREGATION"); !value.empty()) {
+        if (value == "explicit_bucket_histogram" || value == "base2_exponential_bucket_histogram") {
+            env.metrics_default_histogram_aggregation = value;
+        }
+        else {
+            env.metrics_warnings.push_back(std::format(
+                "Environment variable <OTEL_EXPORTER_OTLP_METRICS_DEFAULT_HISTOGRAM_AGGREGATION> has an unknown value "
+                "<{}>, using explicit_bucket_histogram",
+                value
+            ));
+        }
+    }
+
+    // An exponential histogram needs at least two buckets
+    const auto* size_var              = "OTEL_EXPORTER_OTLP_METRICS_EXPONENTIAL_HISTOGRAM_MAX_SIZE";
+    env.exponential_histogram_max_size = std::max<std::size_t>(
+        parse_long(size_var, env.get(size_var), env.exponential_histogram_max_size, env.metrics_warnings), 2
+    );
+
+    // The scales the data model allows
+    const auto* scale_var              = "OTEL_EXPORTER_OTLP_METRICS_EXPONENTIAL_HISTOGRAM_MAX_SCALE";
+    env.exponential_histogram_max_scale = static_cast<std::int32_t>(
+        parse_int(scale_var, env.get(scale_var), env.exponential_histogram_max_scale, -10, 20, env.metrics_warnings)
+    );
+}
+
+std::vector<std::string> split_keys(std::string_view list)
+{
+    std::vector<std::string> keys;
+    std::string_view::size_type start = 0;
+    while (start <= list.size()) {
+        const auto end = std::min(list.find('|', start), list.size());
+        if (const auto key = wwa::opentelemetry::helpers::trim(list.substr(start, end - start)); !key.empty()) {
+            keys.emplace_back(key);
+        }
+
+        start = end + 1;
+    }
+
+    return keys;
+}
+
+std::optional<metric_view_rule_t>
+parse_metric_view(std::string_view rule, const std::string& source, std::vector<std::string>& warnings)
+{
+    using wwa::opentelemetry::helpers::trim;
+
+    const auto colon = rule.find(':');
+    metric_view_rule_t view;
+    view.instrument = trim(rule.substr(0, colon));
+    if (colon == std::string_view::npos || view.instrument.empty()) {
+        warnings.push_back(std::format("{}: invalid view <{}>, ignoring", source, rule));
+        return std::nullopt;
+    }
+
+    for (const auto option : wwa::opentelemetry::helpers::split_and_trim(rule.substr(colon + 1))) {
+        const auto eq    = option.find('=');
+        const auto key   = trim(option.substr(0, eq));
+        const auto value = eq != std::string_view::npos ? trim(option.substr(eq + 1)) : std::string_view{};
+        if (key == "drop" && eq == std::string_view::npos) {
+            view.drop = true;
+        }
+        else if (key == "meter") {
+            view.meter = value;
+        }
+        else if (key == "cardinality_limit") {
+            std::size_t limit = 0;
+            const auto* end   = value.data() + value.size();  // NOLINT(*-pointer-arithmetic)
+            if (const auto [ptr, ec] = std::from_chars(value.data(), end, limit); ec == std::errc{} && ptr == end) {
+                view.cardinality_limit = limit;
+            }
+            else {
+                warnings.push_back(std::format(
+                    "{}: invalid value <{}> of option <cardinality_limit> in view <{}>, ignoring the option", source,
+                    value, rule
+                ));
+            }
+        }
+        else if (key == "attributes") {
+            view.attributes = split_keys(value);
+        }
+        else if (key == "exclude_attributes") {
+            view.excluded_attributes = split_keys(value);
+        }
+        else {
+            warnings.push_back(
+                std::format("{}: unknown option <{}> in view <{}>, ignoring the view", source, key, rule)
+            );
+            return std::nullopt;
+        }
+    }
+
+    return view;
+}
+
+void parse_metric_views(environment_t& env)
+{
+    const std::string views_var       = "OTEL_CPP_METRICS_VIEWS";
+    const auto views                  = env.get(views_var);
+    std::string_view::size_type start = 0;
+    while (start < views.size()) {
+        const auto end = std::min(views.find(';', start), views.size());
+        if (const auto rule = wwa::opentelemetry::helpers::trim(std::string_view(views).substr(start, end - start));
+            !rule.empty()) {
+            if (auto view = parse_metric_view(rule, views_var, env.metrics_warnings); view) {
+                env.metric_views.push_back(std::move(*view));
+            }
+        }
+
+        start = end + 1;
+    }
+
+    const auto path = env.get("OTEL_CPP_METRICS_VIEWS_FILE");
+    if (path.empty()) {
+        return;
+    }
+
+    std::ifstream file(path);
+    if (!file) {
+        env.metrics_warnings.push_back(std::format("Cannot read the metric views from <{}>, ignoring", path));
+        return;
+    }
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (const auto rule = wwa::opentelemetry::helpers::trim(line); !rule.empty() && !rule.starts_with('#')) {
+            if (auto view = parse_metric_view(rule, path, env.metrics_warnings); view) {
+                env.metric_views.push_back(std::move(*view));
+            }
+        }
+    }
+}
+
+/**
+ * The snapshot of the process environment used by the configure_* overloads that do not take one explicitly.
+ * The snapshot itself is immutable; the mutex only guards the pointer, so readers hold it for a pointer copy.
+ * `reported` tells which scopes of the snapshot's warnings have been logged, so that each is only logged once.
+ */
+struct process_environment_t {
+    std::mutex mutex;
+    std::shared_ptr<const environment_t> snapshot;
+    std::array<bool, 4> reported{};
+};
+
+const std::vector<std::string>&
+get_warnings(const environment_t& env, wwa::opentelemetry::environment_scope_t scope) noexcept
+{
+    using wwa::opentelemetry::environment_scope_t;
+
+    switch (scope) {
+        case environment_scope_t::traces:
+            return env.traces_warnings;
+        case environment_scope_t::metrics:
+            return env.metrics_warnings;
+        case environment_scope_t::logs:
+            return env.logs_warnings;
+        default:
+            return env.warnings;
+    }
+}
+
+process_environment_t& process_environment()
+{
+    static process_environment_t instance;
+    return instance;
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+environment_t capture_environment()
+{
+    environment_t env;
+    scan_environment(env);
+
+    env.sdk_disabled = helpers::parse_bool("OTEL_SDK_DISABLED", env.get("OTEL_SDK_DISABLED"), env.warnings);
+    env.log_level    = parse_log_level(env);
+
+    env.traces_exporters  = parse_exporters(env, "OTEL_TRACES_EXPORTER", "Tracing will not be initialized.");
+    env.metrics_exporters =
+        parse_exporters(env, "OTEL_METRICS_EXPORTER", "Metrics exporting will not be initialized.");
+    env.logs_exporters    = parse_exporters(env, "OTEL_LOGS_EXPORTER", "Logging will not be initialized.");
+
+    env.traces_protocol  = parse_otlp_protocol(env, "OTEL_EXPORTER_OTLP_TRACES_PROTOCOL");
+    env.metrics_protocol = parse_otlp_protocol(env, "OTEL_EXPORTER_OTLP_METRICS_PROTOCOL");
+    env.logs_protocol    = parse_otlp_protocol(env, "OTEL_EXPORTER_OTLP_LOGS_PROTOCOL");
+
+    env.propagators = parse_propagators(env);
+
+    env.traces_sampler     = env.get("OTEL_TRACES_SAMPLER");
+    env.traces_sampler_arg = parse_sampler_arg(env);
+
+    if (const auto id_generator = env.get("OTEL_CPP_ID_GENERATOR"); !id_generator.empty()) {
+        if (id_generator == "random" || id_generator == "fast") {
+            env.id_generator = id_generator;
+        }
+        else {
+            env.traces_warnings.push_back(std::format(
+                "Environment variable <OTEL_CPP_ID_GENERATOR> has an unknown value <{}>, ignoring", id_generator
+            ));
+        }
+    }
+
+    env.bsp  = parse_batch_processor(env, "OTEL_BSP", {"ring", "sharded"}, env.traces_warnings);
+    env.blrp = parse_batch_processor(env, "OTEL_BLRP", {"sharded"}, env.logs_warnings);
+    parse_metric_reader(env);
+    parse_metrics_temporality(env);
+    parse_exemplar_filter(env);
+    parse_histogram_aggregation(env);
+    parse_metric_views(env);
+
+    env.export_scheduler_threads = helpers::parse_long(
+        "OTEL_EXPORT_SCHEDULER_THREADS", env.get("OTEL_EXPORT_SCHEDULER_THREADS"), env.export_scheduler_threads,
+        env.warnings
+    );
+
+    env.self_telemetry =
+        helpers::parse_bool("OTEL_SELF_TELEMETRY_ENABLED", env.get("OTEL_SELF_TELEMETRY_ENABLED"), env.warnings);
+
+    return env;
+}
+
+environment_t capture_sampler_environment()
+{
+    environment_t env;
+    scan_environment(env, "OTEL_TRACES_SAMPLER");
+
+    env.traces_sampler     = env.get("OTEL_TRACES_SAMPLER");
+    env.traces_sampler_arg = parse_sampler_arg(env);
+    return env;
+}
+
+std::shared_ptr<const environment_t> get_process_environment()
+{
+    auto& cache = process_environment();
+    const std::lock_guard lock(cache.mutex);
+    if (!cache.snapshot) {
+        // Capture under the lock, so that concurrent first calls scan the environment only once
+        cache.snapshot = std::make_shared<const environment_t>(capture_environment());
+        cache.reported = {};
+    }
+
+    return cache.snapshot;
+}
+
+std::shared_ptr<const environment_t> get_process_environment(environment_scope_t scope)
+{
+    auto snapshot = get_process_environment();
+    report_environment_warnings_once(*snapshot, environment_scope_t::common);
+    report_environment_warnings_once(*snapshot, scope);
+    return snapshot;
+}
+
+void invalidate_process_environment()
+{
+    auto& cache = process_environment();
+    const std::lock_guard lock(cache.mutex);
+    cache.snapshot.reset();
+    cache.reported = {};
+}
+
+std::shared_ptr<const environment_t> reload_process_environment()
+{
+    auto snapshot = std::make_shared<const environment_t>(capture_environment());
+
+    auto& cache = process_environment();
+    const std::lock_guard lock(cache.mutex);
+    cache.snapshot = snapshot;
+    cache.reported = {};
+    return snapshot;
+}
+
+void report_environment_warnings(const environment_t& env)
+{
+    for (const auto scope : {
+             environment_scope_t::common, environment_scope_t::traces, environment_scope_t::metrics,
+             environment_scope_t::logs
+         }) {
+        report_environment_warnings(env, scope);
+    }
+}
+
+void report_environment_warnings(const environment_t& env, environment_scope_t scope)
+{
+    for (const auto& warning : get_warnings(env, scope)) {
+        INTERNAL_LOG_WARN(warning);
+    }
+}
+
+void report_environment_warnings_once(const environment_t& env, environment_scope_t scope)
+{
+    {
+        auto& cache = process_environment();
+        const std::lock_guard lock(cache.mutex);
+        if (cache.snapshot.get() == &env) {
+            auto& reported = cache.reported[static_cast<std::size_t>(scope)];
+            if (reported) {
+                return;
+            }
+
+            reported = true;
+        }
+    }
+
+    report_environment_warnings(env, scope);
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,238 @@
+#ifndef D5B2E8A1_7C4F_4A39_B6D0_1E9F3A7C5B28
+#define D5B2E8A1_7C4F_4A39_B6D0_1E9F3A7C5B28
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <opentelemetry/nostd/span.h>
+
+#include "batching.h"
+#include "queue_stats.h"
+
+namespace wwa::opentelemetry {
+
+/**
+ * Hands the batches of a batching processor over to its exporters.
+ *
+ * The processor gets one instance of its exporter per export slot (see `max_concurrent_exports`). With an export
+ * timeout or more than one instance, every instance gets a slot with its own thread, and the slots export
+ * concurrently: the exporter contract forbids concurrent `Export()` calls on one instance, not on different ones.
+ * Only the first instance creates recordables; the instances are of the same type, so they accept each other's.
+ * Otherwise, the calling thread exports the batches itself.
+ *
+ * An export cannot be cancelled: one running longer than the export timeout is reported, and only holds up its own
+ * slot. How long an export may take is up to the exporter (e.g., `OTEL_EXPORTER_OTLP_TIMEOUT`).
+ */
+template<typename Recordable, typename Exporter>
+class export_dispatcher {
+public:
+    // `exporters` must not be empty; `on_slot_free` is called whenever an export slot becomes free
+    export_dispatcher(
+        std::vector<std::unique_ptr<Exporter>> exporters, const batching_options_t& options, const char* items,
+        std::function<void()> on_slot_free
+    )
+        : m_exporters(std::move(exporters)), m_timeout(options.export_timeout.value_or(default_export_timeout)),
+          m_items(items), m_stats(options.stats), m_on_slot_free(std::move(on_slot_free)),
+          m_slots(options.export_timeout || this->m_exporters.size() > 1 ? this->m_exporters.size() : 0)
+    {
+        // Zero means no limit
+        if (this->m_timeout == std::chrono::microseconds::zero()) {
+            this->m_timeout = std::chrono::microseconds::max();
+        }
+
+        for (std::size_t i = 0; i < this->m_slots.size(); ++i) {
+            auto& slot    = this->m_slots[i];
+            slot.exporter = this->m_exporters[i].get();
+            slot.batch.reserve(options.max_export_batch_size);
+            slot.thread = std::thread(&export_dispatcher::run, this, std::ref(slot));
+        }
+    }
+
+    export_dispatcher(const export_dispatcher&)            = delete;
+    export_dispatcher& operator=(const export_dispatcher&) = delete;
+    export_dispatcher(export_dispatcher&&)                 = delete;
+    export_dispatcher& operator=(export_dispatcher&&)      = delete;
+
+    ~export_dispatcher() { this->stop(); }
+
+    // The instance that creates the recordables
+    Exporter& exporter() noexcept { return *this->m_exporters.front(); }
+
+    /**
+     * Takes the contents of `batch`, leaving it empty. With `block`, waits up to the export timeout for a free
+     * export slot, and drops the batch if none becomes free; otherwise, returns false and leaves `batch` alone
+     * if no slot is free right now.
+     */
+    bool submit(std::vector<std::unique_ptr<Recordable>>& batch, bool block) noexcept
+    {
+        if (this->m_slots.empty()) {
+            this->export_batch(*this->m_exporters.front(), batch);
+            return true;
+        }
+
+        try {
+            std::unique_lock lock(this->m_mutex);
+            slot_t* free_slot    = nullptr;
+            const auto find_free   = [this, &free_slot]() {
+                const auto it = std::ranges::find_if(this->m_slots, [](const auto& s) { return s.sequence == 0; });
+                free_slot     = it != this->m_slots.end() ? &*it : nullptr;
+                return free_slot != nullptr;
+            };
+
+            const bool found = block ? wait_for(this->m_done_cv, lock, this->m_timeout, find_free) : find_free();
+            if (!found && !block) {
+                return false;
+            }
+
+            if (found) {
+                // Swapping keeps the capacity of both buffers
+                free_slot->batch.swap(batch);
+                free_slot->sequence = ++this->m_submitted;
+                lock.unlock();
+                free_slot->cv.notify_one();
+                return true;
+            }
+        }
+        catch (const std::system_error&) {  // NOLINT(bugprone-empty-catch)
+        }
+
+        if (this->m_stats) {
+            this->m_stats->dropped.add(batch.size());
+        }
+
+        log_batching_warning(std::format(
+            "No export slot became free within the export timeout - dropping {} {}.", batch.size(), this->m_items
+        ));
+        batch.clear();
+        return true;
+    }
+
+    // Waits for the batches submitted so far to be exported
+    bool wait(std::chrono::microseconds timeout) noexcept
+    {
+        if (this->m_slots.empty()) {
+            return true;
+        }
+
+        try {
+            std::unique_lock lock(this->m_mutex);
+            const auto target = this->m_submitted;
+            return wait_for(this->m_done_cv, lock, timeout, [this, target]() {
+                return std::ranges::all_of(this->m_slots, [target](const auto& s) {
+                    return s.sequence == 0 || s.sequence > target;
+                });
+            });
+        }
+        catch (const std::system_error&) {
+            return false;
+        }
+    }
+
+    bool shutdown(std::chrono::microseconds timeout) noexcept
+    {
+        this->wait(timeout);
+        // This makes the exporters give up on exports in flight, if they support that
+        bool result = true;
+        for (const auto& exporter : this->m_exporters) {
+            result = exporter->Shutdown(timeout) && result;
+        }
+
+        this->stop();
+        return result;
+    }
+
+private:
+    static constexpr std::chrono::milliseconds default_export_timeout{30'000};
+
+    struct slot_t {
+        Exporter* exporter = nullptr;
+        std::condition_variable cv;
+        std::vector<std::unique_ptr<Recordable>> batch;  // Owned by the slot's thread while sequence != 0
+        std::uint64_t sequence = 0;                      // Guarded by m_mutex; 0 if the slot is free
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Exporter>> m_exporters;
+    std::chrono::microseconds m_timeout;
+    const char* m_items;
+    std::shared_ptr<queue_stats_t> m_stats;
+    std::function<void()> m_on_slot_free;
+
+    std::mutex m_mutex;
+    std::condition_variable m_done_cv;
+    std::vector<slot_t> m_slots;
+    std::uint64_t m_submitted = 0;  // Guarded by m_mutex
+    bool m_stopping           = false;
+
+    void stop() noexcept
+    {
+        try {
+            const std::lock_guard lock(this->m_mutex);
+            this->m_stopping = true;
+        }
+        catch (const std::system_error&) {  // NOLINT(bugprone-empty-catch)
+        }
+
+        for (auto& slot : this->m_slots) {
+            slot.cv.notify_one();
+            if (slot.thread.joinable()) {
+                slot.thread.join();
+            }
+        }
+    }
+
+    static void export_batch(Exporter& exporter, std::vector<std::unique_ptr<Recordable>>& batch) noexcept
+    {
+        exporter.Export(::opentelemetry::nostd::span<std::unique_ptr<Recordable>>(batch.data(), batch.size()));
+        batch.clear();
+    }
+
+    void run(slot_t& slot)
+    {
+        std::unique_lock lock(this->m_mutex);
+        while (true) {
+            slot.cv.wait(lock, [this, &slot]() { return slot.sequence != 0 || this->m_stopping; });
+            if (slot.sequence == 0) {
+                return;
+            }
+
+            lock.unlock();
+
+            const auto start = std::chrono::steady_clock::now();
+            export_batch(*slot.exporter, slot.batch);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+
+            if (elapsed > this->m_timeout) {
+                log_batching_warning(std::format(
+                    "Export of {} took {} ms, longer than the export timeout of {} ms.", this->m_items,
+                    std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(),
+                    std::chrono::duration_cast<std::chrono::milliseconds>(this->m_timeout).count()
+                ));
+            }
+
+            lock.lock();
+            slot.sequence = 0;
+            this->m_done_cv.notify_all();
+            if (this->m_on_slot_free && !this->m_stopping) {
+                lock.unlock();
+                this->m_on_slot_free();
+                lock.lock();
+            }
+        }
+    }
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* D5B2E8A1_7C4F_4A39_B6D0_1E9F3A7C5B28 */
@@ -0,0 +1,175 @@
+#include "export_scheduler.h"
+
+#include <exception>
+#include <format>
+#include <system_error>
+
+#include "configurator_p.h"
+
+namespace {
+
+struct scheduler_registry_t {
+    std::mutex mutex;
+    std::weak_ptr<wwa::opentelemetry::export_scheduler> scheduler;
+};
+
+scheduler_registry_t& scheduler_registry()
+{
+    static scheduler_registry_t instance;
+    return instance;
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+export_scheduler::export_scheduler(std::size_t threads)
+{
+    this->m_workers.reserve(threads);
+    for (std::size_t i = 0; i < threads; ++i) {
+        this->m_workers.emplace_back(&export_scheduler::run, this);
+    }
+}
+
+export_scheduler::~export_scheduler()
+{
+    {
+        const std::lock_guard lock(this->m_mutex);
+        this->m_stopping = true;
+    }
+
+    this->m_cv.notify_all();
+    for (auto& worker : this->m_workers) {
+        worker.join();
+    }
+}
+
+export_scheduler::task_id_t export_scheduler::schedule(task_t task, std::chrono::milliseconds period)
+{
+    const std::lock_guard lock(this->m_mutex);
+    const auto id  = ++this->m_next_id;
+    const auto due = clock_t::now() + period;
+    this->m_tasks.emplace(id, entry_t{.task = std::move(task), .period = period, .due = due});
+    this->m_timers.emplace(due, id);
+    this->m_cv.notify_one();
+    return id;
+}
+
+void export_scheduler::trigger(task_id_t id) noexcept
+{
+    try {
+        const std::lock_guard lock(this->m_mutex);
+        const auto it = this->m_tasks.find(id);
+        if (it == this->m_tasks.end() || it->second.cancelled) {
+            return;
+        }
+
+        auto& entry = it->second;
+        if (entry.running) {
+            entry.triggered = true;
+            return;
+        }
+
+        entry.due = clock_t::now();
+        this->m_timers.emplace(entry.due, id);
+    }
+    catch (const std::exception&) {  // NOLINT(bugprone-empty-catch)
+        // The task will run on schedule
+        return;
+    }
+
+    this->m_cv.notify_one();
+}
+
+void export_scheduler::cancel(task_id_t id) noexcept
+{
+    try {
+        std::unique_lock lock(this->m_mutex);
+        const auto it = this->m_tasks.find(id);
+        if (it == this->m_tasks.end()) {
+            return;
+        }
+
+        if (!it->second.running) {
+            this->m_tasks.erase(it);
+            return;
+        }
+
+        // The worker running the task erases it once it completes
+        it->second.cancelled = true;
+        this->m_done_cv.wait(lock, [this, id]() { return !this->m_tasks.contains(id); });
+    }
+    catch (const std::system_error&) {  // NOLINT(bugprone-empty-catch)
+    }
+}
+
+void export_scheduler::run()
+{
+    std::unique_lock lock(this->m_mutex);
+    while (!this->m_stopping) {
+        if (this->m_timers.empty()) {
+            this->m_cv.wait(lock);
+            continue;
+        }
+
+        const auto [due, id] = this->m_timers.top();
+        const auto it        = this->m_tasks.find(id);
+        if (it == this->m_tasks.end() || it->second.running || it->second.due != due) {
+            this->m_timers.pop();
+            continue;
+        }
+
+        if (due > clock_t::now()) {
+            this->m_cv.wait_until(lock, due);
+            continue;
+        }
+
+        this->m_timers.pop();
+
+        // References to the elements of an unordered_map survive rehashing; cancel() waits until the task completes
+        auto& entry   = it->second;
+        entry.running = true;
+        lock.unlock();
+
+        try {
+            entry.task();
+        }
+        catch (const std::exception& e) {
+            INTERNAL_LOG_WARN(std::format("Export scheduler: task failed: {}", e.what()));
+        }
+        catch (...) {
+            INTERNAL_LOG_WARN("Export scheduler: task failed");
+        }
+
+        lock.lock();
+        entry.running = false;
+        if (entry.cancelled) {
+            this->m_tasks.erase(id);
+            this->m_done_cv.notify_all();
+            continue;
+        }
+
+        entry.due       = entry.triggered ? clock_t::now() : clock_t::now() + entry.period;
+        entry.triggered = false;
+        this->m_timers.emplace(entry.due, id);
+    }
+}
+
+std::shared_ptr<export_scheduler> get_export_scheduler(const environment_t& env)
+{
+    if (env.export_scheduler_threads == 0) {
+        return nullptr;
+    }
+
+    auto& registry = scheduler_registry();
+    const std::lock_guard lock(registry.mutex);
+    auto scheduler = registry.scheduler.lock();
+    if (!scheduler) {
+        scheduler          = std::make_shared<export_scheduler>(env.export_scheduler_threads);
+        registry.scheduler = scheduler;
+    }
+
+    return scheduler;
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,86 @@
+#ifndef E7C1A4B9_3F6D_4E28_9B0A_5D8F2C6E1A43
+#define E7C1A4B9_3F6D_4E28_9B0A_5D8F2C6E1A43
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "opentelemetry/configurator/wwa/environment.h"
+
+namespace wwa::opentelemetry {
+
+/**
+ * A small pool of threads running periodic tasks, shared by the batching processors and metric readers,
+ * so that they do not need a thread each.
+ *
+ * A task runs `period` after its previous run has completed (this is how the SDK processors and readers time
+ * their export cycles), or as soon as possible after `trigger()`. A task never runs concurrently with itself.
+ */
+class export_scheduler {
+public:
+    using task_t    = std::function<void()>;
+    using task_id_t = std::uint64_t;
+
+    explicit export_scheduler(std::size_t threads);
+
+    export_scheduler(const export_scheduler&)            = delete;
+    export_scheduler& operator=(const export_scheduler&) = delete;
+    export_scheduler(export_scheduler&&)                 = delete;
+    export_scheduler& operator=(export_scheduler&&)      = delete;
+    ~export_scheduler();
+
+    task_id_t schedule(task_t task, std::chrono::milliseconds period);
+    void trigger(task_id_t id) noexcept;
+
+    /**
+     * Removes the task; if it is running, waits for it to complete.
+     * Must not be called from the task itself.
+     */
+    void cancel(task_id_t id) noexcept;
+
+private:
+    using clock_t = std::chrono::steady_clock;
+
+    struct entry_t {
+        task_t task;
+        std::chrono::milliseconds period;
+        clock_t::time_point due;
+        bool running   = false;
+        bool triggered = false;  // Triggered while running: run again right away
+        bool cancelled = false;
+    };
+
+    using timer_t = std::pair<clock_t::time_point, task_id_t>;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::condition_variable m_done_cv;
+    std::unordered_map<task_id_t, entry_t> m_tasks;
+    // Stale timers (the task has been cancelled or rescheduled) are skipped when they come up
+    std::priority_queue<timer_t, std::vector<timer_t>, std::greater<>> m_timers;
+    task_id_t m_next_id = 0;
+    bool m_stopping     = false;
+    std::vector<std::thread> m_workers;
+
+    void run();
+};
+
+/**
+ * Returns the process-wide scheduler sized by OTEL_EXPORT_SCHEDULER_THREADS, or `nullptr` when the variable is
+ * not set (every processor and reader then runs its own thread). The scheduler lives as long as the processors
+ * and readers using it; its size is fixed by the first call while it is alive.
+ */
+std::shared_ptr<export_scheduler> get_export_scheduler(const environment_t& env);
+
+}  // namespace wwa::opentelemetry
+
+#endif /* E7C1A4B9_3F6D_4E28_9B0A_5D8F2C6E1A43 */
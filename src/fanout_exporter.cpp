@@ -0,0 +1,721 @@
+#include "fanout_exporter.h"
+
+#include <algorithm>
+#include <exception>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+// The fixed part of a span or a log record: identifiers, timestamps, flags, severity, status...
+constexpr std::size_t recordable_base_size = 128;
+// Trace ID, span ID, and flags of a span link
+constexpr std::size_t span_context_size = 32;
+
+std::size_t attribute_size(const opentelemetry::common::AttributeValue& value) noexcept
+{
+    return opentelemetry::nostd::visit(
+        [](const auto& v) -> std::size_t {
+            using type          = std::decay_t<decltype(v)>;
+            using string_list_t = opentelemetry::nostd::span<const opentelemetry::nostd::string_view>;
+            if constexpr (std::is_same_v<type, const char*>) {
+                return v != nullptr ? std::char_traits<char>::length(v) : 0;
+            }
+            else if constexpr (std::is_same_v<type, opentelemetry::nostd::string_view>) {
+                return v.size();
+            }
+            else if constexpr (std::is_same_v<type, string_list_t>) {
+                std::size_t size = 0;
+                for (const auto& item : v) {
+                    size += item.size();
+                }
+
+                return size;
+            }
+            else if constexpr (std::is_arithmetic_v<type>) {
+                return sizeof(type);
+            }
+            else {
+                return v.size() * sizeof(typename type::element_type);
+            }
+        },
+        value
+    );
+}
+
+std::size_t attributes_size(const opentelemetry::common::KeyValueIterable& attributes) noexcept
+{
+    std::size_t size = 0;
+    attributes.ForEachKeyValue(
+        [&size](opentelemetry::nostd::string_view key, const opentelemetry::common::AttributeValue& value) {
+            size += key.size() + attribute_size(value);
+            return true;
+        }
+    );
+
+    return size;
+}
+
+wwa::opentelemetry::recorded_attributes_t::value_type
+record_attribute(opentelemetry::nostd::string_view key, const opentelemetry::common::AttributeValue& value)
+{
+    return {std::string(key), opentelemetry::nostd::visit(opentelemetry::sdk::common::AttributeConverter(), value)};
+}
+
+wwa::opentelemetry::recorded_attributes_t record_attributes(const opentelemetry::common::KeyValueIterable& attributes)
+{
+    wwa::opentelemetry::recorded_attributes_t result;
+    result.reserve(attributes.size());
+    attributes.ForEachKeyValue(
+        [&result](opentelemetry::nostd::string_view key, const opentelemetry::common::AttributeValue& value) {
+            result.push_back(record_attribute(key, value));
+            return true;
+        }
+    );
+
+    return result;
+}
+
+// Calls `f` with a view of `value`
+template<typename F>
+void with_attribute_value(const opentelemetry::sdk::common::OwnedAttributeValue& value, F&& f)
+{
+    opentelemetry::nostd::visit(
+        [&f](const auto& v) {
+            using type        = std::decay_t<decltype(v)>;
+            using attribute_t = opentelemetry::common::AttributeValue;
+            if constexpr (std::is_same_v<type, std::string>) {
+                f(attribute_t(opentelemetry::nostd::string_view(v)));
+            }
+            else if constexpr (std::is_same_v<type, std::vector<bool>>) {
+                // std::vector<bool> does not store its elements as an array of bool
+                // NOLINTNEXTLINE(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
+                const auto copy = std::make_unique<bool[]>(v.size());
+                std::ranges::copy(v, copy.get());
+                f(attribute_t(opentelemetry::nostd::span<const bool>(copy.get(), v.size())));
+            }
+            else if constexpr (std::is_same_v<type, std::vector<std::string>>) {
+                using view_t = opentelemetry::nostd::string_view;
+                const std::vector<view_t> views(v.begin(), v.end());
+                f(attribute_t(opentelemetry::nostd::span<const view_t>(views.data(), views.size())));
+            }
+            else if constexpr (std::is_arithmetic_v<type>) {
+                f(attribute_t(v));
+            }
+            else {
+                f(attribute_t(opentelemetry::nostd::span<const typename type::value_type>(v.data(), v.size())));
+            }
+        },
+        value
+    );
+}
+
+class recorded_attributes_view : public opentelemetry::common::KeyValueIterable {
+public:
+    using callback_t = opentelemetry::nostd::function_ref<
+        bool(opentelemetry::nostd::string_view, opentelemetry::common::AttributeValue)>;
+
+    explicit recorded_attributes_view(const wwa::opentelemetry::recorded_attributes_t& attributes) noexcept
+        : m_attributes(&attributes)
+    {
+    }
+
+    bool ForEachKeyValue(callback_t callback) const noexcept override
+    {
+        try {
+            for (const auto& [key, value] : *this->m_attributes) {
+                bool proceed = true;
+                with_attribute_value(value, [&](const auto& v) { proceed = callback(key, v); });
+                if (!proceed) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+        catch (const std::bad_alloc&) {
+            return false;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept override { return this->m_attributes->size(); }
+
+private:
+    const wwa::opentelemetry::recorded_attributes_t* m_attributes;
+};
+
+template<typename Recordable>
+void replay_attributes(const wwa::opentelemetry::recorded_attributes_t& attributes, Recordable& recordable)
+{
+    for (const auto& [key, value] : attributes) {
+        with_attribute_value(value, [&](const auto& v) { recordable.SetAttribute(key, v); });
+    }
+}
+
+void replay(const wwa::opentelemetry::span_record_t& record, opentelemetry::sdk::trace::Recordable& recordable)
+{
+    if (record.span_context) {
+        recordable.SetIdentity(*record.span_context, record.parent_span_id);
+    }
+
+    if (record.flags) {
+        recordable.SetTraceFlags(*record.flags);
+    }
+
+    if (record.name) {
+        recordable.SetName(*record.name);
+    }
+
+    if (record.kind) {
+        recordable.SetSpanKind(*record.kind);
+    }
+
+    if (record.status_code) {
+        recordable.SetStatus(*record.status_code, record.status_description);
+    }
+
+    if (record.start_time) {
+        recordable.SetStartTime(*record.start_time);
+    }
+
+    if (record.duration) {
+        recordable.SetDuration(*record.duration);
+    }
+
+    if (record.resource != nullptr) {
+        recordable.SetResource(*record.resource);
+    }
+
+    if (record.scope != nullptr) {
+        recordable.SetInstrumentationScope(*record.scope);
+    }
+
+    replay_attributes(record.attributes, recordable);
+    for (const auto& event : record.events) {
+        recordable.AddEvent(event.name, event.timestamp, recorded_attributes_view(event.attributes));
+    }
+
+    for (const auto& link : record.links) {
+        recordable.AddLink(link.span_context, recorded_attributes_view(link.attributes));
+    }
+}
+
+void replay(const wwa::opentelemetry::log_record_t& record, opentelemetry::sdk::logs::Recordable& recordable)
+{
+    if (record.timestamp) {
+        recordable.SetTimestamp(*record.timestamp);
+    }
+
+    if (record.observed_timestamp) {
+        recordable.SetObservedTimestamp(*record.observed_timestamp);
+    }
+
+    if (record.severity) {
+        recordable.SetSeverity(*record.severity);
+    }
+
+    if (record.body) {
+        with_attribute_value(*record.body, [&](const auto& v) { recordable.SetBody(v); });
+    }
+
+    if (record.event_id) {
+        recordable.SetEventId(*record.event_id, record.event_name);
+    }
+
+    if (record.trace_id) {
+        recordable.SetTraceId(*record.trace_id);
+    }
+
+    if (record.span_id) {
+        recordable.SetSpanId(*record.span_id);
+    }
+
+    if (record.trace_flags) {
+        recordable.SetTraceFlags(*record.trace_flags);
+    }
+
+    if (record.resource != nullptr) {
+        recordable.SetResource(*record.resource);
+    }
+
+    if (record.scope != nullptr) {
+        recordable.SetInstrumentationScope(*record.scope);
+    }
+
+    replay_attributes(record.attributes, recordable);
+}
+
+/**
+ * Converts every fan-out recordable in `records` to a recordable of `exporter`, and exports them.
+ * `batch` is a scratch buffer reused between calls to avoid reallocations.
+ */
+template<typename Fanout, typename Exporter, typename Recordable>
+::opentelemetry::sdk::common::ExportResult export_to(
+    Exporter& exporter, const ::opentelemetry::nostd::span<std::unique_ptr<Recordable>>& records,
+    std::vector<std::unique_ptr<Recordable>>& batch
+) noexcept
+{
+    batch.clear();
+    batch.reserve(records.size());
+    for (const auto& record : records) {
+        // All recordables come from our MakeRecordable()
+        if (auto child = static_cast<Fanout*>(record.get())->take(exporter); child) {
+            batch.push_back(std::move(child));
+        }
+    }
+
+    const auto result =
+        exporter.Export(::opentelemetry::nostd::span<std::unique_ptr<Recordable>>(batch.data(), batch.size()));
+    batch.clear();
+    return result;
+}
+
+template<typename Exporter, typename Fanout, typename Recordable>
+::opentelemetry::sdk::common::ExportResult export_all(
+    const std::vector<std::unique_ptr<Exporter>>& exporters,
+    const ::opentelemetry::nostd::span<std::unique_ptr<Recordable>>& records,
+    std::vector<std::unique_ptr<Recordable>>& batch
+) noexcept
+{
+    auto result = ::opentelemetry::sdk::common::ExportResult::kSuccess;
+    for (const auto& exporter : exporters) {
+        // A failed exporter must not prevent the others from receiving the batch
+        if (const auto res = export_to<Fanout>(*exporter, records, batch);
+            res != ::opentelemetry::sdk::common::ExportResult::kSuccess) {
+            result = res;
+        }
+    }
+
+    return result;
+}
+
+template<typename Exporter, typename F>
+bool for_all_exporters(const std::vector<std::unique_ptr<Exporter>>& exporters, F&& f) noexcept
+{
+    bool result = true;
+    for (const auto& exporter : exporters) {
+        result = f(*exporter) && result;
+    }
+
+    return result;
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+fanout_span_recordable::fanout_span_recordable(std::unique_ptr<::opentelemetry::sdk::trace::Recordable> recordable)
+    : m_recordable(std::move(recordable)), m_size(recordable_base_size)
+{
+}
+
+void fanout_span_recordable::SetIdentity(
+    const ::opentelemetry::trace::SpanContext& span_context, ::opentelemetry::trace::SpanId parent_span_id
+) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetIdentity(span_context, parent_span_id);
+    }
+    else {
+        this->m_record.span_context   = span_context;
+        this->m_record.parent_span_id = parent_span_id;
+    }
+}
+
+void fanout_span_recordable::SetAttribute(
+    ::opentelemetry::nostd::string_view key, const ::opentelemetry::common::AttributeValue& value
+) noexcept
+{
+    this->m_size += key.size() + attribute_size(value);
+    if (this->m_recordable) {
+        this->m_recordable->SetAttribute(key, value);
+    }
+    else {
+        this->m_record.attributes.push_back(record_attribute(key, value));
+    }
+}
+
+void fanout_span_recordable::AddEvent(
+    ::opentelemetry::nostd::string_view name, ::opentelemetry::common::SystemTimestamp timestamp,
+    const ::opentelemetry::common::KeyValueIterable& attributes
+) noexcept
+{
+    this->m_size += name.size() + sizeof(timestamp) + attributes_size(attributes);
+    if (this->m_recordable) {
+        this->m_recordable->AddEvent(name, timestamp, attributes);
+    }
+    else {
+        this->m_record.events.push_back({std::string(name), timestamp, record_attributes(attributes)});
+    }
+}
+
+void fanout_span_recordable::AddLink(
+    const ::opentelemetry::trace::SpanContext& span_context, const ::opentelemetry::common::KeyValueIterable& attributes
+) noexcept
+{
+    this->m_size += span_context_size + attributes_size(attributes);
+    if (this->m_recordable) {
+        this->m_recordable->AddLink(span_context, attributes);
+    }
+    else {
+        this->m_record.links.push_back({span_context, record_attributes(attributes)});
+    }
+}
+
+void fanout_span_recordable::SetStatus(
+    ::opentelemetry::trace::StatusCode code, ::opentelemetry::nostd::string_view description
+) noexcept
+{
+    this->m_size += description.size();
+    if (this->m_recordable) {
+        this->m_recordable->SetStatus(code, description);
+    }
+    else {
+        this->m_record.status_code        = code;
+        this->m_record.status_description = std::string(description);
+    }
+}
+
+void fanout_span_recordable::SetName(::opentelemetry::nostd::string_view name) noexcept
+{
+    this->m_size += name.size();
+    if (this->m_recordable) {
+        this->m_recordable->SetName(name);
+    }
+    else {
+        this->m_record.name = std::string(name);
+    }
+}
+
+void fanout_span_recordable::SetTraceFlags(::opentelemetry::trace::TraceFlags flags) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetTraceFlags(flags);
+    }
+    else {
+        this->m_record.flags = flags;
+    }
+}
+
+void fanout_span_recordable::SetSpanKind(::opentelemetry::trace::SpanKind span_kind) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetSpanKind(span_kind);
+    }
+    else {
+        this->m_record.kind = span_kind;
+    }
+}
+
+void fanout_span_recordable::SetResource(const ::opentelemetry::sdk::resource::Resource& resource) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetResource(resource);
+    }
+    else {
+        // The SDK keeps the resource alive for as long as the recordables
+        this->m_record.resource = &resource;
+    }
+}
+
+void fanout_span_recordable::SetStartTime(::opentelemetry::common::SystemTimestamp start_time) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetStartTime(start_time);
+    }
+    else {
+        this->m_record.start_time = start_time;
+    }
+}
+
+void fanout_span_recordable::SetDuration(std::chrono::nanoseconds duration) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetDuration(duration);
+    }
+    else {
+        this->m_record.duration = duration;
+    }
+}
+
+void fanout_span_recordable::SetInstrumentationScope(
+    const ::opentelemetry::sdk::instrumentationscope::InstrumentationScope& instrumentation_scope
+) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetInstrumentationScope(instrumentation_scope);
+    }
+    else {
+        this->m_record.scope = &instrumentation_scope;
+    }
+}
+
+std::unique_ptr<::opentelemetry::sdk::trace::Recordable>
+fanout_span_recordable::take(::opentelemetry::sdk::trace::SpanExporter& exporter) noexcept
+{
+    if (this->m_recordable) {
+        return std::move(this->m_recordable);
+    }
+
+    try {
+        auto recordable = exporter.MakeRecordable();
+        if (recordable) {
+            replay(this->m_record, *recordable);
+        }
+
+        return recordable;
+    }
+    catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+fanout_span_exporter::fanout_span_exporter(
+    std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>>&& exporters
+)
+    : m_exporters(std::move(exporters))
+{
+}
+
+std::unique_ptr<::opentelemetry::sdk::trace::Recordable> fanout_span_exporter::MakeRecordable() noexcept
+{
+    // With several exporters, each one gets its own recordable only on export
+    return std::make_unique<fanout_span_recordable>(
+        this->m_exporters.size() == 1 ? this->m_exporters.front()->MakeRecordable() : nullptr
+    );
+}
+
+::opentelemetry::sdk::common::ExportResult fanout_span_exporter::Export(
+    const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::trace::Recordable>>& spans
+) noexcept
+{
+    return export_all<::opentelemetry::sdk::trace::SpanExporter, fanout_span_recordable>(
+        this->m_exporters, spans, this->m_batch
+    );
+}
+
+bool fanout_span_exporter::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return for_all_exporters(this->m_exporters, [timeout](auto& exporter) { return exporter.ForceFlush(timeout); });
+}
+
+bool fanout_span_exporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    return for_all_exporters(this->m_exporters, [timeout](auto& exporter) { return exporter.Shutdown(timeout); });
+}
+
+fanout_log_recordable::fanout_log_recordable(std::unique_ptr<::opentelemetry::sdk::logs::Recordable> recordable)
+    : m_recordable(std::move(recordable)), m_size(recordable_base_size)
+{
+}
+
+void fanout_log_recordable::SetTimestamp(::opentelemetry::common::SystemTimestamp timestamp) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetTimestamp(timestamp);
+    }
+    else {
+        this->m_record.timestamp = timestamp;
+    }
+}
+
+void fanout_log_recordable::SetObservedTimestamp(::opentelemetry::common::SystemTimestamp timestamp) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetObservedTimestamp(timestamp);
+    }
+    else {
+        this->m_record.observed_timestamp = timestamp;
+    }
+}
+
+void fanout_log_recordable::SetSeverity(::opentelemetry::logs::Severity severity) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetSeverity(severity);
+    }
+    else {
+        this->m_record.severity = severity;
+    }
+}
+
+void fanout_log_recordable::SetBody(const ::opentelemetry::common::AttributeValue& message) noexcept
+{
+    this->m_size += attribute_size(message);
+    if (this->m_recordable) {
+        this->m_recordable->SetBody(message);
+    }
+    else {
+        this->m_record.body =
+            ::opentelemetry::nostd::visit(::opentelemetry::sdk::common::AttributeConverter(), message);
+    }
+}
+
+void fanout_log_recordable::SetAttribute(
+    ::opentelemetry::nostd::string_view key, const ::opentelemetry::common::AttributeValue& value
+) noexcept
+{
+    this->m_size += key.size() + attribute_size(value);
+    if (this->m_recordable) {
+        this->m_recordable->SetAttribute(key, value);
+    }
+    else {
+        this->m_record.attributes.push_back(record_attribute(key, value));
+    }
+}
+
+void fanout_log_recordable::SetEventId(std::int64_t id, ::opentelemetry::nostd::string_view name) noexcept
+{
+    this->m_size += name.size();
+    if (this->m_recordable) {
+        this->m_recordable->SetEventId(id, name);
+    }
+    else {
+        this->m_record.event_id   = id;
+        this->m_record.event_name = std::string(name);
+    }
+}
+
+void fanout_log_recordable::SetTraceId(const ::opentelemetry::trace::TraceId& trace_id) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetTraceId(trace_id);
+    }
+    else {
+        this->m_record.trace_id = trace_id;
+    }
+}
+
+void fanout_log_recordable::SetSpanId(const ::opentelemetry::trace::SpanId& span_id) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetSpanId(span_id);
+    }
+    else {
+        this->m_record.span_id = span_id;
+    }
+}
+
+void fanout_log_recordable::SetTraceFlags(const ::opentelemetry::trace::TraceFlags& trace_flags) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetTraceFlags(trace_flags);
+    }
+    else {
+        this->m_record.trace_flags = trace_flags;
+    }
+}
+
+void fanout_log_recordable::SetResource(const ::opentelemetry::sdk::resource::Resource& resource) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetResource(resource);
+    }
+    else {
+        this->m_record.resource = &resource;
+    }
+}
+
+void fanout_log_recordable::SetInstrumentationScope(
+    const ::opentelemetry::sdk::instrumentationscope::InstrumentationScope& instrumentation_scope
+) noexcept
+{
+    if (this->m_recordable) {
+        this->m_recordable->SetInstrumentationScope(instrumentation_scope);
+    }
+    else {
+        this->m_record.scope = &instrumentation_scope;
+    }
+}
+
+std::unique_ptr<::opentelemetry::sdk::logs::Recordable>
+fanout_log_recordable::take(::opentelemetry::sdk::logs::LogRecordExporter& exporter) noexcept
+{
+    if (this->m_recordable) {
+        return std::move(this->m_recordable);
+    }
+
+    try {
+        auto recordable = exporter.MakeRecordable();
+        if (recordable) {
+            replay(this->m_record, *recordable);
+        }
+
+        return recordable;
+    }
+    catch (const std::exception&) {
+        return nullptr;
+    }
+}
+
+fanout_log_record_exporter::fanout_log_record_exporter(
+    std::vector<std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>>&& exporters
+)
+    : m_exporters(std::move(exporters))
+{
+}
+
+std::unique_ptr<::opentelemetry::sdk::logs::Recordable> fanout_log_record_exporter::MakeRecordable() noexcept
+{
+    // With several exporters, each one gets its own recordable only on export
+    return std::make_unique<fanout_log_recordable>(
+        this->m_exporters.size() == 1 ? this->m_exporters.front()->MakeRecordable() : nullptr
+    );
+}
+
+::opentelemetry::sdk::common::ExportResult fanout_log_record_exporter::Export(
+    const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::logs::Recordable>>& records
+) noexcept
+{
+    return export_all<::opentelemetry::sdk::logs::LogRecordExporter, fanout_log_recordable>(
+        this->m_exporters, records, this->m_batch
+    );
+}
+
+bool fanout_log_record_exporter::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return for_all_exporters(this->m_exporters, [timeout](auto& exporter) { return exporter.ForceFlush(timeout); });
+}
+
+bool fanout_log_record_exporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    return for_all_exporters(this->m_exporters, [timeout](auto& exporter) { return exporter.Shutdown(timeout); });
+}
+
+std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>
+make_sized_exporter(std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter> exporter)
+{
+    if (dynamic_cast<fanout_span_exporter*>(exporter.get()) != nullptr) {
+        return exporter;
+    }
+
+    std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>> exporters;
+    exporters.push_back(std::move(exporter));
+    return std::make_unique<fanout_span_exporter>(std::move(exporters));
+}
+
+std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>
+make_sized_exporter(std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter> exporter)
+{
+    if (dynamic_cast<fanout_log_record_exporter*>(exporter.get()) != nullptr) {
+        return exporter;
+    }
+
+    std::vector<std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>> exporters;
+    exporters.push_back(std::move(exporter));
+    return std::make_unique<fanout_log_record_exporter>(std::move(exporters));
+}
+
+std::size_t recordable_size(const ::opentelemetry::sdk::trace::Recordable& recordable) noexcept
+{
+    return static_cast<const fanout_span_recordable&>(recordable).size();
+}
+
+std::size_t recordable_size(const ::opentelemetry::sdk::logs::Recordable& recordable) noexcept
+{
+    return static_cast<const fanout_log_recordable&>(recordable).size();
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,233 @@
+#ifndef C9A5E3F8_4D7B_4A26_B1E9_8F3D6C2A0B74
+#define C9A5E3F8_4D7B_4A26_B1E9_8F3D6C2A0B74
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opentelemetry/sdk/common/attribute_utils.h>
+#include <opentelemetry/sdk/logs/exporter.h>
+#include <opentelemetry/sdk/logs/recordable.h>
+#include <opentelemetry/sdk/trace/exporter.h>
+#include <opentelemetry/sdk/trace/recordable.h>
+
+namespace wwa::opentelemetry {
+
+using recorded_attributes_t = std::vector<std::pair<std::string, ::opentelemetry::sdk::common::OwnedAttributeValue>>;
+
+// The data of a span, in no exporter's format; only what has been set is replayed
+struct span_record_t {
+    struct event_t {
+        std::string name;
+        ::opentelemetry::common::SystemTimestamp timestamp;
+        recorded_attributes_t attributes;
+    };
+
+    struct link_t {
+        ::opentelemetry::trace::SpanContext span_context;
+        recorded_attributes_t attributes;
+    };
+
+    std::optional<::opentelemetry::trace::SpanContext> span_context;
+    ::opentelemetry::trace::SpanId parent_span_id;
+    std::optional<::opentelemetry::trace::TraceFlags> flags;
+    std::optional<std::string> name;
+    std::optional<::opentelemetry::trace::SpanKind> kind;
+    std::optional<::opentelemetry::trace::StatusCode> status_code;
+    std::string status_description;
+    std::optional<::opentelemetry::common::SystemTimestamp> start_time;
+    std::optional<std::chrono::nanoseconds> duration;
+    const ::opentelemetry::sdk::resource::Resource* resource                      = nullptr;
+    const ::opentelemetry::sdk::instrumentationscope::InstrumentationScope* scope = nullptr;
+    recorded_attributes_t attributes;
+    std::vector<event_t> events;
+    std::vector<link_t> links;
+};
+
+// The data of a log record, in no exporter's format; only what has been set is replayed
+struct log_record_t {
+    std::optional<::opentelemetry::common::SystemTimestamp> timestamp;
+    std::optional<::opentelemetry::common::SystemTimestamp> observed_timestamp;
+    std::optional<::opentelemetry::logs::Severity> severity;
+    std::optional<::opentelemetry::sdk::common::OwnedAttributeValue> body;
+    std::optional<std::int64_t> event_id;
+    std::string event_name;
+    std::optional<::opentelemetry::trace::TraceId> trace_id;
+    std::optional<::opentelemetry::trace::SpanId> span_id;
+    std::optional<::opentelemetry::trace::TraceFlags> trace_flags;
+    const ::opentelemetry::sdk::resource::Resource* resource                      = nullptr;
+    const ::opentelemetry::sdk::instrumentationscope::InstrumentationScope* scope = nullptr;
+    recorded_attributes_t attributes;
+};
+
+/**
+ * Span recordable of a fan-out exporter. With a single exporter, it records straight into that exporter's recordable;
+ * otherwise, it records the span once, and each exporter gets its own recordable only on export.
+ *
+ * The recordable also estimates how much memory the recorded data takes, for the byte-bounded queues.
+ */
+class fanout_span_recordable : public ::opentelemetry::sdk::trace::Recordable {
+public:
+    // `recordable`: the recordable of the exporter, if there is only one
+    explicit fanout_span_recordable(std::unique_ptr<::opentelemetry::sdk::trace::Recordable> recordable);
+
+    void SetIdentity(
+        const ::opentelemetry::trace::SpanContext& span_context, ::opentelemetry::trace::SpanId parent_span_id
+    ) noexcept override;
+    void SetAttribute(
+        ::opentelemetry::nostd::string_view key, const ::opentelemetry::common::AttributeValue& value
+    ) noexcept override;
+    void AddEvent(
+        ::opentelemetry::nostd::string_view name, ::opentelemetry::common::SystemTimestamp timestamp,
+        const ::opentelemetry::common::KeyValueIterable& attributes
+    ) noexcept override;
+    void AddLink(
+        const ::opentelemetry::trace::SpanContext& span_context,
+        const ::opentelemetry::common::KeyValueIterable& attributes
+    ) noexcept override;
+    void SetStatus(
+        ::opentelemetry::trace::StatusCode code, ::opentelemetry::nostd::string_view description
+    ) noexcept override;
+    void SetName(::opentelemetry::nostd::string_view name) noexcept override;
+    void SetTraceFlags(::opentelemetry::trace::TraceFlags flags) noexcept override;
+    void SetSpanKind(::opentelemetry::trace::SpanKind span_kind) noexcept override;
+    void SetResource(const ::opentelemetry::sdk::resource::Resource& resource) noexcept override;
+    void SetStartTime(::opentelemetry::common::SystemTimestamp start_time) noexcept override;
+    void SetDuration(std::chrono::nanoseconds duration) noexcept override;
+    void SetInstrumentationScope(
+        const ::opentelemetry::sdk::instrumentationscope::InstrumentationScope& instrumentation_scope
+    ) noexcept override;
+
+    // The span as a recordable of `exporter`; returns nullptr if that fails
+    std::unique_ptr<::opentelemetry::sdk::trace::Recordable>
+    take(::opentelemetry::sdk::trace::SpanExporter& exporter) noexcept;
+
+    // Estimated size of the recorded data, in bytes
+    [[nodiscard]] std::size_t size() const noexcept { return this->m_size; }
+
+private:
+    std::unique_ptr<::opentelemetry::sdk::trace::Recordable> m_recordable;
+    span_record_t m_record;
+    std::size_t m_size;
+};
+
+/**
+ * Delivers every batch to all exporters, so that one processor (and one queue) can serve several exporters.
+ * Exporters are called one after another; a slow exporter delays the others. The spans are converted
+ * to each exporter's recordables on export.
+ */
+class fanout_span_exporter : public ::opentelemetry::sdk::trace::SpanExporter {
+public:
+    explicit fanout_span_exporter(std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>>&& exporters);
+
+    std::unique_ptr<::opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
+    ::opentelemetry::sdk::common::ExportResult
+    Export(const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::trace::Recordable>>& spans
+    ) noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+    [[nodiscard]] const std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>>&
+    exporters() const noexcept
+    {
+        return this->m_exporters;
+    }
+
+private:
+    std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>> m_exporters;
+    // Scratch buffer of Export(), which the exporter contract never calls concurrently
+    std::vector<std::unique_ptr<::opentelemetry::sdk::trace::Recordable>> m_batch;
+};
+
+// Log record counterpart of fanout_span_recordable
+class fanout_log_recordable : public ::opentelemetry::sdk::logs::Recordable {
+public:
+    // `recordable`: the recordable of the exporter, if there is only one
+    explicit fanout_log_recordable(std::unique_ptr<::opentelemetry::sdk::logs::Recordable> recordable);
+
+    void SetTimestamp(::opentelemetry::common::SystemTimestamp timestamp) noexcept override;
+    void SetObservedTimestamp(::opentelemetry::common::SystemTimestamp timestamp) noexcept override;
+    void SetSeverity(::opentelemetry::logs::Severity severity) noexcept override;
+    void SetBody(const ::opentelemetry::common::AttributeValue& message) noexcept override;
+    void SetAttribute(
+        ::opentelemetry::nostd::string_view key, const ::opentelemetry::common::AttributeValue& value
+    ) noexcept override;
+    void SetEventId(std::int64_t id, ::opentelemetry::nostd::string_view name) noexcept override;
+    void SetTraceId(const ::opentelemetry::trace::TraceId& trace_id) noexcept override;
+    void SetSpanId(const ::opentelemetry::trace::SpanId& span_id) noexcept override;
+    void SetTraceFlags(const ::opentelemetry::trace::TraceFlags& trace_flags) noexcept override;
+    void SetResource(const ::opentelemetry::sdk::resource::Resource& resource) noexcept override;
+    void SetInstrumentationScope(
+        const ::opentelemetry::sdk::instrumentationscope::InstrumentationScope& instrumentation_scope
+    ) noexcept override;
+
+    // The log record as a recordable of `exporter`; returns nullptr if that fails
+    std::unique_ptr<::opentelemetry::sdk::logs::Recordable>
+    take(::opentelemetry::sdk::logs::LogRecordExporter& exporter) noexcept;
+
+    // Estimated size of the recorded data, in bytes
+    [[nodiscard]] std::size_t size() const noexcept { return this->m_size; }
+
+private:
+    std::unique_ptr<::opentelemetry::sdk::logs::Recordable> m_recordable;
+    log_record_t m_record;
+    std::size_t m_size;
+};
+
+class fanout_log_record_exporter : public ::opentelemetry::sdk::logs::LogRecordExporter {
+public:
+    explicit fanout_log_record_exporter(
+        std::vector<std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>>&& exporters
+    );
+
+    std::unique_ptr<::opentelemetry::sdk::logs::Recordable> MakeRecordable() noexcept override;
+    ::opentelemetry::sdk::common::ExportResult
+    Export(const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::logs::Recordable>>& records
+    ) noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+    [[nodiscard]] const std::vector<std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>>&
+    exporters() const noexcept
+    {
+        return this->m_exporters;
+    }
+
+private:
+    std::vector<std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>> m_exporters;
+    // Scratch buffer of Export(), which the exporter contract never calls concurrently
+    std::vector<std::unique_ptr<::opentelemetry::sdk::logs::Recordable>> m_batch;
+};
+
+/**
+ * Wrap an exporter into a fan-out exporter (unless it is one already), so that the sizes of its recordables
+ * are known: the byte-bounded processors need them.
+ */
+std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>
+make_sized_exporter(std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter> exporter);
+std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>
+make_sized_exporter(std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter> exporter);
+
+// make_sized_exporter() for every instance of an exporter
+template<typename Exporter>
+std::vector<std::unique_ptr<Exporter>> make_sized_exporters(std::vector<std::unique_ptr<Exporter>> exporters)
+{
+    for (auto& exporter : exporters) {
+        exporter = make_sized_exporter(std::move(exporter));
+    }
+
+    return exporters;
+}
+
+// Estimated size of a span or log record created by a fan-out exporter
+std::size_t recordable_size(const ::opentelemetry::sdk::trace::Recordable& recordable) noexcept;
+std::size_t recordable_size(const ::opentelemetry::sdk::logs::Recordable& recordable) noexcept;
+
+}  // namespace wwa::opentelemetry
+
+#endif /* C9A5E3F8_4D7B_4A26_B1E9_8F3D6C2A0B74 */
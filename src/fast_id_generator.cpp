@@ -0,0 +1,167 @@
+#include "fast_id_generator.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#ifndef _WIN32
+#    include <pthread.h>
+#endif
+
+#include <opentelemetry/nostd/span.h>
+#include <opentelemetry/trace/span_id.h>
+#include <opentelemetry/trace/trace_id.h>
+
+namespace {
+
+// Bumped in the child after a fork, so that the child does not repeat the IDs of its parent
+std::atomic<std::uint64_t> fork_generation{0};
+
+std::uint64_t splitmix64(std::uint64_t& x) noexcept
+{
+    std::uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+    z               = (z ^ (z >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+    z               = (z ^ (z >> 27U)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31U);
+}
+
+constexpr std::uint64_t rotl(std::uint64_t x, unsigned int k) noexcept
+{
+    return (x << k) | (x >> (64U - k));
+}
+
+// xoshiro256**, see https://prng.di.unimi.it/
+std::uint64_t xoshiro256ss(std::array<std::uint64_t, 4>& s) noexcept
+{
+    const auto result = rotl(s[1] * 5, 7) * 9;
+    const auto t      = s[1] << 17U;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+class id_pool {
+public:
+    std::uint64_t next() noexcept
+    {
+        if (this->m_generation != fork_generation.load(std::memory_order_relaxed)) {
+            this->seed();
+        }
+
+        if (this->m_next == this->m_block.size()) {
+            this->refill();
+        }
+
+        return this->m_block[this->m_next++];
+    }
+
+private:
+    static constexpr std::size_t block_size = 64;
+
+    std::array<std::uint64_t, 4> m_state{};
+    std::array<std::uint64_t, block_size> m_block{};
+    std::size_t m_next         = block_size;
+    std::uint64_t m_generation = ~std::uint64_t{0};  // Never a valid generation: forces seeding on the first use
+
+    void seed() noexcept
+    {
+        this->m_generation = fork_generation.load(std::memory_order_relaxed);
+        this->m_next       = block_size;  // The block drawn before a fork would repeat in the child
+
+        try {
+            std::random_device device;
+            for (auto& word : this->m_state) {
+                word = (static_cast<std::uint64_t>(device()) << 32U) | device();
+            }
+        }
+        catch (...) {
+            // No entropy source: fall back to the clock and the thread ID
+            auto x = static_cast<std::uint64_t>(std::chrono::high_resolution_clock::now().time_since_epoch().count()) ^
+                     std::hash<std::thread::id>{}(std::this_thread::get_id());
+            for (auto& word : this->m_state) {
+                word = splitmix64(x);
+            }
+        }
+
+        // xoshiro256** must not start from the all-zero state
+        if ((this->m_state[0] | this->m_state[1] | this->m_state[2] | this->m_state[3]) == 0) {
+            this->m_state[0] = 0x9E3779B97F4A7C15ULL;
+        }
+    }
+
+    void refill() noexcept
+    {
+        for (auto& value : this->m_block) {
+            value = xoshiro256ss(this->m_state);
+        }
+
+        this->m_next = 0;
+    }
+};
+
+id_pool& get_pool() noexcept
+{
+    thread_local id_pool pool;
+    return pool;
+}
+
+std::uint64_t next_nonzero() noexcept
+{
+    auto& pool = get_pool();
+    std::uint64_t value = 0;
+    do {
+        value = pool.next();
+    } while (value == 0);
+
+    return value;
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+fast_id_generator::fast_id_generator() : IdGenerator(true)
+{
+#ifndef _WIN32
+    static std::once_flag once;
+    std::call_once(once, []() {
+        ::pthread_atfork(nullptr, nullptr, []() { fork_generation.fetch_add(1, std::memory_order_relaxed); });
+    });
+#endif
+}
+
+::opentelemetry::trace::SpanId fast_id_generator::GenerateSpanId() noexcept
+{
+    const auto value = next_nonzero();
+
+    std::array<std::uint8_t, ::opentelemetry::trace::SpanId::kSize> id{};
+    std::memcpy(id.data(), &value, sizeof(value));
+    return ::opentelemetry::trace::SpanId(id);
+}
+
+::opentelemetry::trace::TraceId fast_id_generator::GenerateTraceId() noexcept
+{
+    // The second half alone is never zero, hence neither is the whole ID
+    auto& pool      = get_pool();
+    const auto high = pool.next();
+    const auto low  = next_nonzero();
+
+    std::array<std::uint8_t, ::opentelemetry::trace::TraceId::kSize> id{};
+    std::memcpy(id.data(), &high, sizeof(high));
+    std::memcpy(id.data() + sizeof(high), &low, sizeof(low));
+    return ::opentelemetry::trace::TraceId(id);
+}
+
+}  // namespace wwa::opentelemetry
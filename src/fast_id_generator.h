@@ -0,0 +1,25 @@
+#ifndef A6C3E9F1_4B27_4D85_8E0A_3F7B1D9C2E64
+#define A6C3E9F1_4B27_4D85_8E0A_3F7B1D9C2E64
+
+#include <opentelemetry/sdk/trace/id_generator.h>
+
+namespace wwa::opentelemetry {
+
+/**
+ * Generates the IDs with a per-thread xoshiro256** generator, seeded from the OS on the first use in every thread
+ * (and again after a fork), and drawn in blocks.
+ *
+ * All bits of the IDs are random, as the W3C Trace Context random flag requires; an all-zero ID is never returned.
+ * The generator is not cryptographically secure.
+ */
+class fast_id_generator : public ::opentelemetry::sdk::trace::IdGenerator {
+public:
+    fast_id_generator();
+
+    ::opentelemetry::trace::SpanId GenerateSpanId() noexcept override;
+    ::opentelemetry::trace::TraceId GenerateTraceId() noexcept override;
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* A6C3E9F1_4B27_4D85_8E0A_3F7B1D9C2E64 */
@@ -2,12 +2,10 @@
 
 #include <algorithm>
 #include <cctype>
-#include <cstdlib>
+#include <charconv>
 #include <format>
 #include <stdexcept>
 
-#include "configurator_p.h"
-
 namespace {
 
 const char* const spaces = " \t\n\r\f\v";
@@ -56,12 +54,6 @@ std::vector<std::string_view> split_and_trim(std::string_view s)
     return result;
 }
 
-std::string get_env(const char* name)
-{
-    const char* env = std::getenv(name);  // NOLINT(concurrency-mt-unsafe)
-    return env != nullptr ? env : std::string();
-}
-
 /**
  * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/#boolean-value
  *
@@ -72,23 +64,21 @@ std::string get_env(const char* name)
  * > case-insensitive string "false", empty, or unset is used, a warning SHOULD be logged to inform users
  * > about the fallback to false being applied.
  */
-bool get_env_bool(const char* name)
+bool parse_bool(const std::string& name, const std::string& value, std::vector<std::string>& warnings)
 {
-    const char* env = std::getenv(name);  // NOLINT(concurrency-mt-unsafe)
-    if (env == nullptr || *env == '\0') {
+    if (value.empty()) {
         return false;
     }
 
-    if (case_insensitive_compare(env, "true")) {
+    if (case_insensitive_compare(value, "true")) {
         return true;
     }
 
-    if (case_insensitive_compare(env, "false")) {
+    if (case_insensitive_compare(value, "false")) {
         return false;
     }
 
-    INTERNAL_LOG_WARN(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, env));
-
+    warnings.push_back(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, value));
     return false;
 }
 
@@ -103,68 +93,93 @@ bool get_env_bool(const char* name)
  *
  * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/#numeric-value
  */
-unsigned long int get_env_long(const char* name, unsigned long int default_value)
+unsigned long int parse_long(
+    const std::string& name, const std::string& value, unsigned long int default_value,
+    std::vector<std::string>& warnings
+)
 {
-    const char* env = std::getenv(name);  // NOLINT(concurrency-mt-unsafe)
-    if (env == nullptr || *env == '\0') {
+    if (value.empty()) {
         return default_value;
     }
 
     try {
-        auto value = std::stol(env);
-        if (value >= 0) {
-            return static_cast<unsigned long int>(value);
+        auto v = std::stol(value);
+        if (v >= 0) {
+            return static_cast<unsigned long int>(v);
         }
 
-        INTERNAL_LOG_WARN(
-            std::format("Environment variable <{}> has a value <{}>, outside the valid range, ignoring", name, env)
+        warnings.push_back(
+            std::format("Environment variable <{}> has a value <{}>, outside the valid range, ignoring", name, value)
         );
     }
     catch (const std::invalid_argument&) {
-        INTERNAL_LOG_WARN(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, env));
+        warnings.push_back(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, value));
     }
     catch (const std::out_of_range&) {
-        INTERNAL_LOG_WARN(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, env));
+        warnings.push_back(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, value));
     }
 
     return default_value;
 }
 
-double get_env_double(const char* name, double default_value, double min, double max)
+/**
+ * Like parse_long(), but for the integers that may be negative, and strict: the whole value must be an integer
+ * in [min, max] (so that, e.g., "1.5" is not taken for 1).
+ */
+long int parse_int(
+    const std::string& name, const std::string& value, long int default_value, long int min, long int max,
+    std::vector<std::string>& warnings
+)
 {
-    const char* env = std::getenv(name);  // NOLINT(concurrency-mt-unsafe)
-    if (env == nullptr || *env == '\0') {
+    if (value.empty()) {
         return default_value;
     }
 
-    try {
-        auto value = std::stod(env);
-        if (value >= min && value <= max) {
-            return value;
-        }
-
-        INTERNAL_LOG_WARN(
-            std::format("Environment variable <{}> has a value <{}>, outside the valid range, ignoring", name, env)
-        );
+    long int v           = 0;
+    const auto* end      = value.data() + value.size();  // NOLINT(*-pointer-arithmetic)
+    const auto [ptr, ec] = std::from_chars(value.data(), end, v);
+    if (ec == std::errc::invalid_argument || ptr != end) {
+        warnings.push_back(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, value));
     }
-    catch (const std::invalid_argument&) {
-        INTERNAL_LOG_WARN(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, env));
+    else if (ec == std::errc::result_out_of_range || v < min || v > max) {
+        warnings.push_back(
+            std::format("Environment variable <{}> has a value <{}>, outside the valid range, ignoring", name, value)
+        );
     }
-    catch (const std::out_of_range&) {
-        INTERNAL_LOG_WARN(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, env));
+    else {
+        return v;
     }
 
     return default_value;
 }
 
-std::string get_otlp_protocol(const char* env, const char* backup, const std::string& default_value)
+double parse_double(
+    const std::string& name, const std::string& value, double default_value, double min, double max,
+    std::vector<std::string>& warnings
+)
 {
-    auto value = get_env(env);
     if (value.empty()) {
-        value = get_env(backup);
+        return default_value;
+    }
+
+    try {
+        auto v = std::stod(value);
+        if (v >= min && v <= max) {
+            return v;
+        }
+
+        warnings.push_back(
+            std::format("Environment variable <{}> has a value <{}>, outside the valid range, ignoring", name, value)
+        );
+    }
+    catch (const std::invalid_argument&) {
+        warnings.push_back(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, value));
+    }
+    catch (const std::out_of_range&) {
+        warnings.push_back(std::format("Environment variable <{}> has an invalid value <{}>, ignoring", name, value));
     }
 
-    return value.empty() ? default_value : value;
+    return default_value;
 }
 
 }  // namespace wwa::opentelemetry::helpers
@@ -9,11 +9,19 @@ namespace wwa::opentelemetry::helpers {
 
 std::string_view trim(std::string_view s);
 std::vector<std::string_view> split_and_trim(std::string_view s);
-std::string get_env(const char* name);
-bool get_env_bool(const char* name);
-unsigned long int get_env_long(const char* name, unsigned long int default_value);
-double get_env_double(const char* name, double default_value, double min, double max);
-std::string get_otlp_protocol(const char* env, const char* backup, const std::string& default_value);
+bool parse_bool(const std::string& name, const std::string& value, std::vector<std::string>& warnings);
+unsigned long int parse_long(
+    const std::string& name, const std::string& value, unsigned long int default_value,
+    std::vector<std::string>& warnings
+);
+long int parse_int(
+    const std::string& name, const std::string& value, long int default_value, long int min, long int max,
+    std::vector<std::string>& warnings
+);
+double parse_double(
+    const std::string& name, const std::string& value, double default_value, double min, double max,
+    std::vector<std::string>& warnings
+);
 
 }  // namespace wwa::opentelemetry::helpers
 
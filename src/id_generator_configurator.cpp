@@ -1,12 +1,20 @@
+#include <memory>
+
 #include <opentelemetry/sdk/trace/random_id_generator_factory.h>
 
 #include "configurator_p.h"
+#include "fast_id_generator.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace wwa::opentelemetry {
 
-id_generator_t get_id_generator()
+id_generator_t get_id_generator(const environment_t& env)
 {
+    if (env.id_generator == "fast") {
+        return std::make_unique<fast_id_generator>();
+    }
+
     return ::opentelemetry::sdk::trace::RandomIdGeneratorFactory::Create();
 }
 
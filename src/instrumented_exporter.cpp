@@ -0,0 +1,158 @@
+#include "instrumented_exporter.h"
+
+#include <utility>
+
+#include <opentelemetry/sdk/metrics/export/metric_producer.h>
+
+#include "fanout_exporter.h"
+
+namespace {
+
+template<typename Exporter, typename Batch>
+opentelemetry::sdk::common::ExportResult timed_export(
+    Exporter& exporter, wwa::opentelemetry::exporter_telemetry_t& telemetry, const Batch& batch, std::size_t items
+) noexcept
+{
+    const auto start  = std::chrono::steady_clock::now();
+    const auto result = exporter.Export(batch);
+    wwa::opentelemetry::record_export(
+        telemetry, items, std::chrono::steady_clock::now() - start,
+        result == opentelemetry::sdk::common::ExportResult::kSuccess
+    );
+
+    return result;
+}
+
+template<typename Instrumented, typename Fanout, typename Exporter>
+std::string exporter_name(const Exporter& exporter)
+{
+    if (const auto* instrumented = dynamic_cast<const Instrumented*>(&exporter); instrumented != nullptr) {
+        return instrumented->name();
+    }
+
+    if (const auto* fanout = dynamic_cast<const Fanout*>(&exporter); fanout != nullptr) {
+        std::string result;
+        for (const auto& child : fanout->exporters()) {
+            if (!result.empty()) {
+                result += ',';
+            }
+
+            result += exporter_name<Instrumented, Fanout>(*child);
+        }
+
+        return result;
+    }
+
+    return "unknown";
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+instrumented_span_exporter::instrumented_span_exporter(
+    std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter> exporter, std::shared_ptr<exporter_telemetry_t> telemetry
+)
+    : m_exporter(std::move(exporter)), m_telemetry(std::move(telemetry))
+{
+}
+
+std::unique_ptr<::opentelemetry::sdk::trace::Recordable> instrumented_span_exporter::MakeRecordable() noexcept
+{
+    return this->m_exporter->MakeRecordable();
+}
+
+::opentelemetry::sdk::common::ExportResult instrumented_span_exporter::Export(
+    const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::trace::Recordable>>& spans
+) noexcept
+{
+    return timed_export(*this->m_exporter, *this->m_telemetry, spans, spans.size());
+}
+
+bool instrumented_span_exporter::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_exporter->ForceFlush(timeout);
+}
+
+bool instrumented_span_exporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_exporter->Shutdown(timeout);
+}
+
+instrumented_log_record_exporter::instrumented_log_record_exporter(
+    std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter> exporter,
+    std::shared_ptr<exporter_telemetry_t> telemetry
+)
+    : m_exporter(std::move(exporter)), m_telemetry(std::move(telemetry))
+{
+}
+
+std::unique_ptr<::opentelemetry::sdk::logs::Recordable> instrumented_log_record_exporter::MakeRecordable() noexcept
+{
+    return this->m_exporter->MakeRecordable();
+}
+
+::opentelemetry::sdk::common::ExportResult instrumented_log_record_exporter::Export(
+    const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::logs::Recordable>>& records
+) noexcept
+{
+    return timed_export(*this->m_exporter, *this->m_telemetry, records, records.size());
+}
+
+bool instrumented_log_record_exporter::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_exporter->ForceFlush(timeout);
+}
+
+bool instrumented_log_record_exporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_exporter->Shutdown(timeout);
+}
+
+instrumented_metric_exporter::instrumented_metric_exporter(
+    std::unique_ptr<::opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+    std::shared_ptr<exporter_telemetry_t> telemetry
+)
+    : m_exporter(std::move(exporter)), m_telemetry(std::move(telemetry))
+{
+}
+
+::opentelemetry::sdk::common::ExportResult
+instrumented_metric_exporter::Export(const ::opentelemetry::sdk::metrics::ResourceMetrics& data) noexcept
+{
+    std::size_t metrics = 0;
+    for (const auto& scope : data.scope_metric_data_) {
+        metrics += scope.metric_data_.size();
+    }
+
+    return timed_export(*this->m_exporter, *this->m_telemetry, data, metrics);
+}
+
+::opentelemetry::sdk::metrics::AggregationTemporality instrumented_metric_exporter::GetAggregationTemporality(
+    ::opentelemetry::sdk::metrics::InstrumentType instrument_type
+) const noexcept
+{
+    return this->m_exporter->GetAggregationTemporality(instrument_type);
+}
+
+bool instrumented_metric_exporter::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_exporter->ForceFlush(timeout);
+}
+
+bool instrumented_metric_exporter::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_exporter->Shutdown(timeout);
+}
+
+std::string get_exporter_name(const ::opentelemetry::sdk::trace::SpanExporter& exporter)
+{
+    return exporter_name<instrumented_span_exporter, fanout_span_exporter>(exporter);
+}
+
+std::string get_exporter_name(const ::opentelemetry::sdk::logs::LogRecordExporter& exporter)
+{
+    return exporter_name<instrumented_log_record_exporter, fanout_log_record_exporter>(exporter);
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,92 @@
+#ifndef B9F4C7E2_0A6D_4B58_9E31_6C2A8D5F4B07
+#define B9F4C7E2_0A6D_4B58_9E31_6C2A8D5F4B07
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <opentelemetry/sdk/logs/exporter.h>
+#include <opentelemetry/sdk/logs/recordable.h>
+#include <opentelemetry/sdk/metrics/instruments.h>
+#include <opentelemetry/sdk/metrics/push_metric_exporter.h>
+#include <opentelemetry/sdk/trace/exporter.h>
+#include <opentelemetry/sdk/trace/recordable.h>
+
+#include "self_telemetry.h"
+
+namespace wwa::opentelemetry {
+
+// The exporters below time every export and count the items and failures for self-telemetry
+
+class instrumented_span_exporter : public ::opentelemetry::sdk::trace::SpanExporter {
+public:
+    instrumented_span_exporter(
+        std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter> exporter,
+        std::shared_ptr<exporter_telemetry_t> telemetry
+    );
+
+    std::unique_ptr<::opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
+    ::opentelemetry::sdk::common::ExportResult
+    Export(const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::trace::Recordable>>& spans
+    ) noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+    [[nodiscard]] const std::string& name() const noexcept { return this->m_telemetry->exporter; }
+
+private:
+    std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter> m_exporter;
+    std::shared_ptr<exporter_telemetry_t> m_telemetry;
+};
+
+class instrumented_log_record_exporter : public ::opentelemetry::sdk::logs::LogRecordExporter {
+public:
+    instrumented_log_record_exporter(
+        std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter> exporter,
+        std::shared_ptr<exporter_telemetry_t> telemetry
+    );
+
+    std::unique_ptr<::opentelemetry::sdk::logs::Recordable> MakeRecordable() noexcept override;
+    ::opentelemetry::sdk::common::ExportResult
+    Export(const ::opentelemetry::nostd::span<std::unique_ptr<::opentelemetry::sdk::logs::Recordable>>& records
+    ) noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+    [[nodiscard]] const std::string& name() const noexcept { return this->m_telemetry->exporter; }
+
+private:
+    std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter> m_exporter;
+    std::shared_ptr<exporter_telemetry_t> m_telemetry;
+};
+
+// Counts the metrics (not the data points) of every export as its items
+class instrumented_metric_exporter : public ::opentelemetry::sdk::metrics::PushMetricExporter {
+public:
+    instrumented_metric_exporter(
+        std::unique_ptr<::opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+        std::shared_ptr<exporter_telemetry_t> telemetry
+    );
+
+    ::opentelemetry::sdk::common::ExportResult
+    Export(const ::opentelemetry::sdk::metrics::ResourceMetrics& data) noexcept override;
+    ::opentelemetry::sdk::metrics::AggregationTemporality
+    GetAggregationTemporality(::opentelemetry::sdk::metrics::InstrumentType instrument_type) const noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+private:
+    std::unique_ptr<::opentelemetry::sdk::metrics::PushMetricExporter> m_exporter;
+    std::shared_ptr<exporter_telemetry_t> m_telemetry;
+};
+
+/**
+ * The name used to label the processor of `exporter`: the name of an instrumented exporter,
+ * or the names of the exporters behind a fan-out exporter.
+ */
+std::string get_exporter_name(const ::opentelemetry::sdk::trace::SpanExporter& exporter);
+std::string get_exporter_name(const ::opentelemetry::sdk::logs::LogRecordExporter& exporter);
+
+}  // namespace wwa::opentelemetry
+
+#endif /* B9F4C7E2_0A6D_4B58_9E31_6C2A8D5F4B07 */
@@ -1,26 +1,8 @@
-#include <array>
-#include <format>
-#include <string_view>
-#include <utility>
-
 #include <opentelemetry/sdk/common/global_log_handler.h>
 
 #include "configurator_p.h"
-#include "helpers.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
-
-namespace {
-
-using namespace std::literals;
-constexpr std::array<std::pair<std::string_view, opentelemetry::sdk::common::internal_log::LogLevel>, 5> log_levels{
-    {{"none"sv, opentelemetry::sdk::common::internal_log::LogLevel::None},
-     {"error"sv, opentelemetry::sdk::common::internal_log::LogLevel::Error},
-     {"warning"sv, opentelemetry::sdk::common::internal_log::LogLevel::Warning},
-     {"info"sv, opentelemetry::sdk::common::internal_log::LogLevel::Info},
-     {"debug"sv, opentelemetry::sdk::common::internal_log::LogLevel::Debug}}
-};
-
-}  // namespace
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace wwa::opentelemetry {
 
@@ -43,26 +25,13 @@ void internal_log(
 
 void configure_internal_logging_from_environment()
 {
-    auto level = ::opentelemetry::sdk::common::internal_log::LogLevel::Info;
-
-    if (const auto log_level = helpers::get_env("OTEL_LOG_LEVEL"); !log_level.empty()) {
-        bool found = false;
-        for (const auto& [name, value] : log_levels) {
-            if (log_level == name) {
-                level = value;
-                found = true;
-                break;
-            }
-        }
-
-        if (!found) {
-            INTERNAL_LOG_WARN(
-                std::format("Environment variable <OTEL_LOG_LEVEL> has an unknown value <{}>, ignoring", log_level)
-            );
-        }
-    }
+    configure_internal_logging_from_environment(*get_process_environment());
+}
 
-    ::opentelemetry::sdk::common::internal_log::GlobalLogHandler::SetLogLevel(level);
+void configure_internal_logging_from_environment(const environment_t& env)
+{
+    ::opentelemetry::sdk::common::internal_log::GlobalLogHandler::SetLogLevel(env.log_level);
+    report_environment_warnings_once(env, environment_scope_t::common);
 }
 
 }  // namespace wwa::opentelemetry
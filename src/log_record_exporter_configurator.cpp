@@ -1,5 +1,5 @@
-#include <algorithm>
 #include <format>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -14,16 +14,15 @@
 #endif
 
 #include "configurator_p.h"
-#include "helpers.h"
+#include "instrumented_exporter.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace {
 
-wwa::opentelemetry::log_record_exporter_t configure_otlp()
+wwa::opentelemetry::log_record_exporter_t configure_otlp(const wwa::opentelemetry::environment_t& env)
 {
-    using wwa::opentelemetry::helpers::get_otlp_protocol;
-    const auto protocol =
-        get_otlp_protocol("OTEL_EXPORTER_OTLP_LOGS_PROTOCOL", "OTEL_EXPORTER_OTLP_PROTOCOL", "http/protobuf");
+    const auto& protocol = env.logs_protocol;
 
 #if !defined(OTEL_LOG_EXPORTER_OTLP_GRPC_DISABLED)
     if (protocol == "grpc") {
@@ -45,10 +44,13 @@ wwa::opentelemetry::log_record_exporter_t configure_otlp()
 }
 
 wwa::opentelemetry::log_record_exporter_t
-get_log_record_exporter(std::string_view name, wwa::opentelemetry::log_record_exporter_factory_t factory)
+get_log_record_exporter(
+    std::string_view name, wwa::opentelemetry::log_record_exporter_factory_t factory,
+    const wwa::opentelemetry::environment_t& env
+)
 {
     if (name == "otlp") {
-        return configure_otlp();
+        return configure_otlp(env);
     }
 
     return factory != nullptr ? factory(name) : nullptr;
@@ -61,30 +63,24 @@ namespace wwa::opentelemetry {
 std::vector<log_record_exporter_t>
 configure_log_record_exporters_from_environment(const log_record_exporter_config_t& opts)
 {
-    const auto exporters_env = helpers::get_env("OTEL_LOGS_EXPORTER");
-    auto names               = helpers::split_and_trim(exporters_env);
-
-    if (names.size() == 1 && names[0] == "none") {
-        INTERNAL_LOG_WARN("OTEL_LOGS_EXPORTER contains \"none\". Logging will not be initialized.");
-        return {};
-    }
-
-    if (names.empty()) {
-        INTERNAL_LOG_WARN("OTEL_LOGS_EXPORTER is empty. Using default otlp exporter.");
-        names = {"otlp"};
-    }
-    else if (std::ranges::find(names, "none") != names.end()) {
-        INTERNAL_LOG_WARN(
-            "OTEL_LOGS_EXPORTER contains \"none\" along with other exporters. Using default otlp exporter."
-        );
+    return configure_log_record_exporters_from_environment(opts, *get_process_environment(environment_scope_t::logs));
+}
 
-        names = {"otlp"};
-    }
+std::vector<log_record_exporter_t>
+configure_log_record_exporters_from_environment(const log_record_exporter_config_t& opts, const environment_t& env)
+{
+    const auto& names = env.logs_exporters;
 
     std::vector<wwa::opentelemetry::log_record_exporter_t> exporters;
     exporters.reserve(names.size());
     for (const auto& name : names) {
-        if (auto exporter = get_log_record_exporter(name, opts.factory); exporter) {
+        if (auto exporter = get_log_record_exporter(name, opts.factory, env); exporter) {
+            if (env.self_telemetry) {
+                exporter = std::make_unique<instrumented_log_record_exporter>(
+                    std::move(exporter), make_exporter_telemetry("logs", name)
+                );
+            }
+
             exporters.push_back(std::move(exporter));
         }
         else {
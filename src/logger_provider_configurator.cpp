@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -6,22 +9,38 @@
 #include <opentelemetry/sdk/resource/resource.h>
 
 #include "configurator_p.h"
+#include "fanout_exporter.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace wwa::opentelemetry {
 
-// NOLINTNEXTLINE(cppcoreguidelines-rvalue-reference-param-not-moved)
 logger_provider_t configure_logger_provider(logger_provider_config_t&& opts)
 {
-    std::vector<log_record_exporter_t> exporters;
-    if (opts.configure_exporters) {
-        exporters = configure_log_record_exporters_from_environment(opts.log_record_exporter_config);
+    return configure_logger_provider(std::move(opts), *get_process_environment(environment_scope_t::logs));
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-rvalue-reference-param-not-moved)
+logger_provider_t configure_logger_provider(logger_provider_config_t&& opts, const environment_t& env)
+{
+    // Every export slot of a processor gets instances of its own, so that the exports can run concurrently
+    std::vector<std::vector<log_record_exporter_t>> instances;
+    const auto copies = opts.configure_exporters ? std::max<std::size_t>(env.blrp.max_concurrent_exports, 1) : 0;
+    for (std::size_t i = 0; i < copies; ++i) {
+        auto exporters = configure_log_record_exporters_from_environment(opts.log_record_exporter_config, env);
+        if (env.blrp.fanout && exporters.size() > 1) {
+            log_record_exporter_t fanout = std::make_unique<fanout_log_record_exporter>(std::move(exporters));
+            exporters.clear();
+            exporters.push_back(std::move(fanout));
+        }
+
+        add_exporter_instances(instances, std::move(exporters));
     }
 
     std::vector<log_record_processor_t> processors;
-    processors.reserve(exporters.size() + opts.processors.size());
-    for (auto&& exporter : exporters) {
-        processors.push_back(get_batch_log_record_processor(std::move(exporter)));
+    processors.reserve(instances.size() + opts.processors.size());
+    for (auto&& exporters : instances) {
+        processors.push_back(get_batch_log_record_processor(std::move(exporters), env));
     }
 
     for (auto&& processor : opts.processors) {
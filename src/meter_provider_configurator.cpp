@@ -1,38 +1,218 @@
+#include <algorithm>
+#include <array>
 #include <memory>
+#include <string>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include <opentelemetry/sdk/metrics/aggregation/aggregation_config.h>
+#ifdef ENABLE_METRICS_EXEMPLAR_PREVIEW
+#    include <opentelemetry/sdk/metrics/exemplar/filter_type.h>
+#endif
+#include <opentelemetry/sdk/metrics/instruments.h>
 #include <opentelemetry/sdk/metrics/meter_provider.h>
 #include <opentelemetry/sdk/metrics/meter_provider_factory.h>
 #include <opentelemetry/sdk/metrics/metric_reader.h>
+#include <opentelemetry/sdk/metrics/view/attributes_processor.h>
+#include <opentelemetry/sdk/metrics/view/instrument_selector_factory.h>
+#include <opentelemetry/sdk/metrics/view/meter_selector_factory.h>
+#include <opentelemetry/sdk/metrics/view/view_factory.h>
 #include <opentelemetry/sdk/metrics/view/view_registry.h>
 #include <opentelemetry/sdk/metrics/view/view_registry_factory.h>
 #include <opentelemetry/sdk/resource/resource.h>
 
 #include "configurator_p.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
+#include "self_telemetry.h"
+
+namespace {
+
+using wwa::opentelemetry::environment_t;
+using wwa::opentelemetry::metric_view_rule_t;
+
+bool exponential_histograms(const environment_t& env)
+{
+    return env.metrics_default_histogram_aggregation == "base2_exponential_bucket_histogram";
+}
+
+std::shared_ptr<opentelemetry::sdk::metrics::Base2ExponentialHistogramAggregationConfig>
+make_exponential_config(const environment_t& env)
+{
+    auto config          = std::make_shared<opentelemetry::sdk::metrics::Base2ExponentialHistogramAggregationConfig>();
+    config->max_buckets_ = env.exponential_histogram_max_size;
+    config->max_scale_   = env.exponential_histogram_max_scale;
+    return config;
+}
+
+void add_exponential_histogram_view(opentelemetry::sdk::metrics::ViewRegistry& registry, const environment_t& env)
+{
+    using namespace opentelemetry::sdk::metrics;
+
+    // An empty meter name and the "*" instrument name match everything
+    registry.AddView(
+        InstrumentSelectorFactory::Create(InstrumentType::kHistogram, "*", ""),
+        MeterSelectorFactory::Create("", "", ""),
+        ViewFactory::Create("", "", AggregationType::kBase2ExponentialHistogram, make_exponential_config(env))
+    );
+}
+
+void set_exemplar_filter(opentelemetry::sdk::metrics::MeterProvider& provider, const environment_t& env)
+{
+#ifdef ENABLE_METRICS_EXEMPLAR_PREVIEW
+    using opentelemetry::sdk::metrics::ExemplarFilterType;
+
+    // trace_based is the default of the specification
+    auto filter = ExemplarFilterType::kTraceBased;
+    if (env.metrics_exemplar_filter == "always_on") {
+        filter = ExemplarFilterType::kAlwaysOn;
+    }
+    else if (env.metrics_exemplar_filter == "always_off") {
+        filter = ExemplarFilterType::kAlwaysOff;
+    }
+
+    provider.SetExemplarFilter(filter);
+#else
+    // Without exemplar support, the SDK records no exemplars: "always_off" is what we already have
+    if (env.metrics_exemplar_filter == "always_on") {
+        INTERNAL_LOG_WARN(
+            "OTEL_METRICS_EXEMPLAR_FILTER is ignored: OpenTelemetry was built without ENABLE_METRICS_EXEMPLAR_PREVIEW"
+        );
+    }
+    static_cast<void>(provider);
+#endif
+}
+
+std::unique_ptr<opentelemetry::sdk::metrics::AttributesProcessor>
+make_attributes_processor(const metric_view_rule_t& rule)
+{
+    using namespace opentelemetry::sdk::metrics;
+
+    std::unordered_map<std::string, bool> keys;
+    if (!rule.attributes.empty()) {
+        for (const auto& key : rule.attributes) {
+            if (std::ranges::find(rule.excluded_attributes, key) == rule.excluded_attributes.end()) {
+                keys.emplace(key, true);
+            }
+        }
+
+        return std::make_unique<FilteringAttributesProcessor>(std::move(keys));
+    }
+
+    if (!rule.excluded_attributes.empty()) {
+        for (const auto& key : rule.excluded_attributes) {
+            keys.emplace(key, true);
+        }
+
+        return std::make_unique<FilteringExcludeAttributesProcessor>(std::move(keys));
+    }
+
+    return std::make_unique<DefaultAttributesProcessor>();
+}
+
+void add_rule_views(
+    opentelemetry::sdk::metrics::ViewRegistry& registry, const metric_view_rule_t& rule, const environment_t& env
+)
+{
+    using namespace opentelemetry::sdk::metrics;
+
+    // An instrument selector matches a single instrument type
+    static constexpr std::array types = {
+        InstrumentType::kCounter,           InstrumentType::kHistogram,        InstrumentType::kUpDownCounter,
+        InstrumentType::kObservableCounter, InstrumentType::kObservableGauge,  InstrumentType::kObservableUpDownCounter,
+        InstrumentType::kGauge,
+    };
+
+    for (const auto type : types) {
+        // Each aggregation reads its own configuration type: the limit has to be set on the matching one
+        auto aggregation = AggregationType::kDefault;
+        std::shared_ptr<AggregationConfig> config;
+        if (rule.drop) {
+            aggregation = AggregationType::kDrop;
+        }
+        else if (type == InstrumentType::kHistogram && exponential_histograms(env)) {
+            aggregation = AggregationType::kBase2ExponentialHistogram;
+            config      = make_exponential_config(env);
+        }
+        else if (type == InstrumentType::kHistogram) {
+            aggregation = AggregationType::kHistogram;
+            config      = std::make_shared<HistogramAggregationConfig>();
+        }
+        else {
+            config = std::make_shared<AggregationConfig>();
+        }
+
+        if (config && rule.cardinality_limit != 0) {
+            config->cardinality_limit_ = rule.cardinality_limit;
+        }
+
+        registry.AddView(
+            InstrumentSelectorFactory::Create(type, rule.instrument, ""),
+            MeterSelectorFactory::Create(rule.meter, "", ""),
+            ViewFactory::Create("", "", aggregation, std::move(config), make_attributes_processor(rule))
+        );
+    }
+}
+
+}  // namespace
 
 namespace wwa::opentelemetry {
 
 meter_provider_t configure_meter_provider(meter_provider_config_t&& opts)
+{
+    return configure_meter_provider(std::move(opts), *get_process_environment(environment_scope_t::metrics));
+}
+
+meter_provider_t configure_meter_provider(meter_provider_config_t&& opts, const environment_t& env)
 {
     std::vector<metric_exporter_t> exporters;
     if (opts.configure_exporters) {
-        exporters = configure_metric_exporters_from_environment(opts.metric_exporter_config);
+        exporters = configure_metric_exporters_from_environment(opts.metric_exporter_config, env);
     }
 
     auto resource = std::holds_alternative<resource_config_t>(opts.resource)
                         ? configure_resource(std::get<resource_config_t>(opts.resource))
                         : std::get<::opentelemetry::sdk::resource::Resource>(opts.resource);
 
-    auto view_registry = opts.view_registry != nullptr ? std::move(opts.view_registry)
-                                                       : ::opentelemetry::sdk::metrics::ViewRegistryFactory::Create();
+    const bool own_registry = opts.view_registry == nullptr;
+    auto view_registry      = !own_registry ? std::move(opts.view_registry)
+                                            : ::opentelemetry::sdk::metrics::ViewRegistryFactory::Create();
+
+    for (const auto& rule : env.metric_views) {
+        add_rule_views(*view_registry, rule, env);
+    }
+
+    if (exponential_histograms(env)) {
+        // A catch-all view would duplicate the histograms that other views already match,
+        // and would keep exporting the histograms that the rules drop
+        if (!own_registry) {
+            INTERNAL_LOG_WARN(
+                "OTEL_EXPORTER_OTLP_METRICS_DEFAULT_HISTOGRAM_AGGREGATION is ignored when a view registry is provided"
+            );
+        }
+        else if (!env.metric_views.empty()) {
+            INTERNAL_LOG_WARN(
+                "OTEL_EXPORTER_OTLP_METRICS_DEFAULT_HISTOGRAM_AGGREGATION only applies to the histograms matched "
+                "by the metric views from the environment"
+            );
+        }
+        else {
+            add_exponential_histogram_view(*view_registry, env);
+        }
+    }
 
     auto provider = ::opentelemetry::sdk::metrics::MeterProviderFactory::Create(std::move(view_registry), resource);
 
+    set_exemplar_filter(*provider, env);
+
     for (auto&& exporter : exporters) {
-        provider->AddMetricReader(get_periodic_exporting_metric_reader(std::move(exporter)));
+        provider->AddMetricReader(get_periodic_exporting_metric_reader(std::move(exporter), env));
+    }
+
+    if (env.self_telemetry) {
+        enable_self_telemetry(*provider);
     }
 
     return provider;
@@ -1,5 +1,5 @@
-#include <algorithm>
 #include <format>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -7,38 +7,68 @@
 
 #if !defined(OTEL_METRICS_EXPORTER_OTLP_GRPC_DISABLED)
 #    include <opentelemetry/exporters/otlp/otlp_grpc_metric_exporter_factory.h>
+#    include <opentelemetry/exporters/otlp/otlp_grpc_metric_exporter_options.h>
 #endif
 
 #if !defined(OTEL_METRICS_EXPORTER_OTLP_HTTP_DISABLED)
 #    include <opentelemetry/exporters/otlp/otlp_http_metric_exporter_factory.h>
+#    include <opentelemetry/exporters/otlp/otlp_http_metric_exporter_options.h>
 #endif
 
+#include <opentelemetry/exporters/otlp/otlp_preferred_temporality.h>
+
 #include "configurator_p.h"
-#include "helpers.h"
+#include "instrumented_exporter.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace {
 
-wwa::opentelemetry::metric_exporter_t configure_otlp()
+opentelemetry::exporter::otlp::PreferredAggregationTemporality
+get_temporality(const wwa::opentelemetry::environment_t& env)
 {
-    using wwa::opentelemetry::helpers::get_otlp_protocol;
+    using opentelemetry::exporter::otlp::PreferredAggregationTemporality;
+
+    // Delta temporality lets the SDK forget the attribute sets that have not been updated since the last export
+    if (env.metrics_temporality_preference == "delta") {
+        return PreferredAggregationTemporality::kDelta;
+    }
 
-    const auto protocol =
-        get_otlp_protocol("OTEL_EXPORTER_OTLP_METRICS_PROTOCOL", "OTEL_EXPORTER_OTLP_PROTOCOL", "http/protobuf");
+    if (env.metrics_temporality_preference == "lowmemory") {
+        return PreferredAggregationTemporality::kLowMemory;
+    }
+
+    return PreferredAggregationTemporality::kCumulative;
+}
+
+#if !defined(OTEL_METRICS_EXPORTER_OTLP_HTTP_DISABLED)
+wwa::opentelemetry::metric_exporter_t create_otlp_http(const wwa::opentelemetry::environment_t& env)
+{
+    opentelemetry::exporter::otlp::OtlpHttpMetricExporterOptions options;
+    options.aggregation_temporality = get_temporality(env);
+    return opentelemetry::exporter::otlp::OtlpHttpMetricExporterFactory::Create(options);
+}
+#endif
+
+wwa::opentelemetry::metric_exporter_t configure_otlp(const wwa::opentelemetry::environment_t& env)
+{
+    const auto& protocol = env.metrics_protocol;
 
 #if !defined(OTEL_METRICS_EXPORTER_OTLP_GRPC_DISABLED)
     if (protocol == "grpc") {
-        return opentelemetry::exporter::otlp::OtlpGrpcMetricExporterFactory::Create();
+        opentelemetry::exporter::otlp::OtlpGrpcMetricExporterOptions options;
+        options.aggregation_temporality = get_temporality(env);
+        return opentelemetry::exporter::otlp::OtlpGrpcMetricExporterFactory::Create(options);
     }
 #endif
 
 #if !defined(OTEL_METRICS_EXPORTER_OTLP_HTTP_DISABLED)
     if (protocol.starts_with("http/")) {
-        return opentelemetry::exporter::otlp::OtlpHttpMetricExporterFactory::Create();
+        return create_otlp_http(env);
     }
 
     INTERNAL_LOG_WARN(std::format("Unsupported OTLP logs protocol: <{}>, using http/protobuf", protocol));
-    return opentelemetry::exporter::otlp::OtlpHttpMetricExporterFactory::Create();
+    return create_otlp_http(env);
 #else
     INTERNAL_LOG_WARN(std::format("Unsupported OTLP logs protocol: <{}>", protocol));
     return nullptr;
@@ -46,10 +76,13 @@ wwa::opentelemetry::metric_exporter_t configure_otlp()
 }
 
 wwa::opentelemetry::metric_exporter_t
-get_metric_exporter(std::string_view name, wwa::opentelemetry::metric_exporter_factory_t factory)
+get_metric_exporter(
+    std::string_view name, wwa::opentelemetry::metric_exporter_factory_t factory,
+    const wwa::opentelemetry::environment_t& env
+)
 {
     if (name == "otlp") {
-        return configure_otlp();
+        return configure_otlp(env);
     }
 
     return factory != nullptr ? factory(name) : nullptr;
@@ -61,30 +94,24 @@ namespace wwa::opentelemetry {
 
 std::vector<metric_exporter_t> configure_metric_exporters_from_environment(const metric_exporter_config_t& opts)
 {
-    const auto exporters_env = helpers::get_env("OTEL_METRICS_EXPORTER");
-    auto names               = helpers::split_and_trim(exporters_env);
-
-    if (names.size() == 1 && names[0] == "none") {
-        INTERNAL_LOG_WARN("OTEL_METRICS_EXPORTER contains \"none\". Metrics exporting will not be initialized.");
-        return {};
-    }
-
-    if (names.empty()) {
-        INTERNAL_LOG_WARN("OTEL_METRICS_EXPORTER is empty. Using default otlp exporter.");
-        names = {"otlp"};
-    }
-    else if (std::ranges::find(names, "none") != names.end()) {
-        INTERNAL_LOG_WARN(
-            "OTEL_METRICS_EXPORTER contains \"none\" along with other exporters. Using default otlp exporter."
-        );
+    return configure_metric_exporters_from_environment(opts, *get_process_environment(environment_scope_t::metrics));
+}
 
-        names = {"otlp"};
-    }
+std::vector<metric_exporter_t>
+configure_metric_exporters_from_environment(const metric_exporter_config_t& opts, const environment_t& env)
+{
+    const auto& names = env.metrics_exporters;
 
     std::vector<wwa::opentelemetry::metric_exporter_t> exporters;
     exporters.reserve(names.size());
     for (const auto& name : names) {
-        if (auto exporter = get_metric_exporter(name, opts.factory); exporter) {
+        if (auto exporter = get_metric_exporter(name, opts.factory, env); exporter) {
+            if (env.self_telemetry) {
+                exporter = std::make_unique<instrumented_metric_exporter>(
+                    std::move(exporter), make_exporter_telemetry("metrics", name)
+                );
+            }
+
             exporters.push_back(std::move(exporter));
         }
         else {
@@ -1,4 +1,4 @@
-#include <chrono>
+#include <memory>
 #include <utility>
 
 #include <opentelemetry/sdk/metrics/export/periodic_exporting_metric_reader_factory.h>
@@ -6,32 +6,25 @@
 #include <opentelemetry/sdk/metrics/push_metric_exporter.h>
 
 #include "configurator_p.h"
-#include "helpers.h"
+#include "export_scheduler.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
+#include "scheduled_metric_reader.h"
 
 namespace wwa::opentelemetry {
 
-/**
- * @see https://opentelemetry.io/docs/specs/otel/configuration/sdk-environment-variables/#periodic-exporting-metricreader
- */
-metric_reader_t get_periodic_exporting_metric_reader(metric_exporter_t&& exporter)
+metric_reader_t get_periodic_exporting_metric_reader(metric_exporter_t&& exporter, const environment_t& env)
 {
-    using wwa::opentelemetry::helpers::get_env_long;
-
-    static bool initialized = false;
-    static ::opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions options;
-
-    if (!initialized) {
-        constexpr auto default_interval = 60'000UL;
-        constexpr auto default_timeout  = 30'000UL;
-
-        options.export_interval_millis =
-            std::chrono::milliseconds(get_env_long("OTEL_METRIC_EXPORT_INTERVAL", default_interval));
-        options.export_timeout_millis =
-            std::chrono::milliseconds(get_env_long("OTEL_METRIC_EXPORT_TIMEOUT", default_timeout));
-        initialized = true;
+    if (auto scheduler = get_export_scheduler(env); scheduler) {
+        return std::make_unique<scheduled_metric_reader>(
+            std::move(exporter), env.metric_export_interval, env.metric_export_timeout, std::move(scheduler)
+        );
     }
 
+    ::opentelemetry::sdk::metrics::PeriodicExportingMetricReaderOptions options;
+    options.export_interval_millis = env.metric_export_interval;
+    options.export_timeout_millis  = env.metric_export_timeout;
+
     return ::opentelemetry::sdk::metrics::PeriodicExportingMetricReaderFactory::Create(std::move(exporter), options);
 }
 
@@ -1,8 +1,8 @@
 #include <array>
 #include <format>
 #include <memory>
+#include <string>
 #include <string_view>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -13,8 +13,8 @@
 #include <opentelemetry/trace/propagation/http_trace_context.h>
 
 #include "configurator_p.h"
-#include "helpers.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace {
 
@@ -53,7 +53,7 @@ propagator_t find_propagator(std::string_view name, wwa::opentelemetry::propagat
 }
 
 std::vector<std::unique_ptr<opentelemetry::context::propagation::TextMapPropagator>>
-get_propagators(const std::unordered_set<std::string_view>&& names, wwa::opentelemetry::propagator_factory_t factory)
+get_propagators(const std::vector<std::string>& names, wwa::opentelemetry::propagator_factory_t factory)
 {
     if (factory == nullptr) {
         factory = default_factory_impl;
@@ -73,36 +73,18 @@ get_propagators(const std::unordered_set<std::string_view>&& names, wwa::opentel
     return propagators;
 }
 
-std::unordered_set<std::string_view> get_propagator_names()
-{
-    using namespace wwa::opentelemetry::helpers;
-
-    const auto env  = get_env("OTEL_PROPAGATORS");
-    const auto list = split_and_trim(env);
-    if (list.empty()) {
-        return {"tracecontext", "baggage"};
-    }
-
-    std::unordered_set<std::string_view> names(list.begin(), list.end());
-    if (names.size() == 1 && names.count("none") == 1) {
-        return {};
-    }
-
-    if (names.count("none") == 1) {
-        INTERNAL_LOG_WARN("OTEL_PROPAGATORS contains <none> along with other propagators. Using default propagators.");
-        return {"tracecontext", "baggage"};
-    }
-
-    return names;
-}
-
 }  // namespace
 
 namespace wwa::opentelemetry {
 
 propagator_t configure_propagators_from_environment(const propagator_config_t& opts)
 {
-    auto propagators = get_propagators(get_propagator_names(), opts.factory);
+    return configure_propagators_from_environment(opts, *get_process_environment(environment_scope_t::common));
+}
+
+propagator_t configure_propagators_from_environment(const propagator_config_t& opts, const environment_t& env)
+{
+    auto propagators = get_propagators(env.propagators, opts.factory);
     return propagator_t(new ::opentelemetry::context::propagation::CompositePropagator(std::move(propagators)));
 }
 
@@ -0,0 +1,53 @@
+#include "queue_stats.h"
+
+#include <mutex>
+
+namespace {
+
+struct queue_stats_registry_t {
+    std::mutex mutex;
+    std::vector<std::weak_ptr<wwa::opentelemetry::queue_stats_t>> entries;
+};
+
+queue_stats_registry_t& queue_stats_registry()
+{
+    static queue_stats_registry_t instance;
+    return instance;
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+std::shared_ptr<queue_stats_t>
+make_queue_stats(const std::string& signal, const std::string& exporter, std::size_t capacity)
+{
+    auto stats      = std::make_shared<queue_stats_t>();
+    stats->signal   = signal;
+    stats->exporter = exporter;
+    stats->capacity = capacity;
+
+    auto& registry = queue_stats_registry();
+    const std::lock_guard lock(registry.mutex);
+    std::erase_if(registry.entries, [](const auto& entry) { return entry.expired(); });
+    registry.entries.push_back(stats);
+    return stats;
+}
+
+std::vector<std::shared_ptr<queue_stats_t>> get_queue_stats()
+{
+    std::vector<std::shared_ptr<queue_stats_t>> result;
+
+    auto& registry = queue_stats_registry();
+    const std::lock_guard lock(registry.mutex);
+    result.reserve(registry.entries.size());
+    for (const auto& entry : registry.entries) {
+        if (auto stats = entry.lock(); stats) {
+            result.push_back(std::move(stats));
+        }
+    }
+
+    return result;
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,78 @@
+#ifndef C7E2A4F9_3B6D_4E18_A5C1_8D0F6B2E9A43
+#define C7E2A4F9_3B6D_4E18_A5C1_8D0F6B2E9A43
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "batching.h"
+#include "bounded_queue.h"
+
+namespace wwa::opentelemetry {
+
+/**
+ * Counter split into cache-line-sized cells picked by the calling thread, so that threads updating it concurrently
+ * do not fight over a cache line. The cells are only summed up when the counter is read.
+ */
+class striped_counter {
+public:
+    void add(std::uint64_t value = 1) noexcept
+    {
+        this->m_cells[get_thread_slot() % cell_count].value.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::uint64_t load() const noexcept
+    {
+        std::uint64_t sum = 0;
+        for (const auto& cell : this->m_cells) {
+            sum += cell.value.load(std::memory_order_relaxed);
+        }
+
+        return sum;
+    }
+
+private:
+    static constexpr std::size_t cell_count = 16;
+
+    struct alignas(cache_line_size) cell_t {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::array<cell_t, cell_count> m_cells{};
+};
+
+/**
+ * Counters of the queue of a batching processor implemented by this library, updated by the processor itself:
+ * `enqueued` counts the items accepted into the queue, `dequeued` the items taken out by the export cycles, and
+ * `dropped` the items lost anywhere on the way (full queue or shard, byte limits, no free export slot).
+ * Read by the adaptive sampler and by self-telemetry.
+ */
+struct queue_stats_t {
+    std::string signal;
+    std::string exporter;
+    std::size_t capacity = 0;
+    striped_counter enqueued;
+    striped_counter dropped;
+    std::atomic<std::uint64_t> dequeued{0};  // Only updated by the export cycle
+
+    [[nodiscard]] std::uint64_t pending() const noexcept
+    {
+        // The counters are read one after another: do not let a concurrent export cycle make the size negative
+        const auto done  = this->dequeued.load(std::memory_order_relaxed);
+        const auto added = this->enqueued.load();
+        return added > done ? added - done : 0;
+    }
+};
+
+std::shared_ptr<queue_stats_t>
+make_queue_stats(const std::string& signal, const std::string& exporter, std::size_t capacity);
+// Stats of all live processors created by this library
+std::vector<std::shared_ptr<queue_stats_t>> get_queue_stats();
+
+}  // namespace wwa::opentelemetry
+
+#endif /* C7E2A4F9_3B6D_4E18_A5C1_8D0F6B2E9A43 */
@@ -0,0 +1,82 @@
+#include "rate_limiting_sampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+
+namespace {
+
+constexpr std::int64_t nanoseconds_per_second = 1'000'000'000;
+
+std::int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+std::int64_t get_interval(double rate) noexcept
+{
+    // Also rejects NaN
+    if (!(rate > 0.0)) {
+        return 0;
+    }
+
+    // Cap the interval at about 30 years to stay away from overflows
+    constexpr double max_interval = 1e18;
+    return std::max<std::int64_t>(
+        1, static_cast<std::int64_t>(std::min(static_cast<double>(nanoseconds_per_second) / rate, max_interval))
+    );
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+rate_limiting_sampler::rate_limiting_sampler(double rate)
+    : m_interval(get_interval(rate)), m_tolerance(std::max<std::int64_t>(0, nanoseconds_per_second - this->m_interval)),
+      m_description(std::format("RateLimitingSampler{{{:f}}}", rate))
+{
+}
+
+::opentelemetry::sdk::trace::SamplingResult rate_limiting_sampler::ShouldSample(
+    const ::opentelemetry::trace::SpanContext& parent_context, ::opentelemetry::trace::TraceId,
+    ::opentelemetry::nostd::string_view, ::opentelemetry::trace::SpanKind,
+    const ::opentelemetry::common::KeyValueIterable&, const ::opentelemetry::trace::SpanContextKeyValueIterable&
+) noexcept
+{
+    using ::opentelemetry::sdk::trace::Decision;
+
+    if (this->admit()) {
+        return {Decision::RECORD_AND_SAMPLE, nullptr, parent_context.trace_state()};
+    }
+
+    return {Decision::DROP, nullptr, parent_context.trace_state()};
+}
+
+::opentelemetry::nostd::string_view rate_limiting_sampler::GetDescription() const noexcept
+{
+    return this->m_description;
+}
+
+bool rate_limiting_sampler::admit() noexcept
+{
+    if (this->m_interval == 0) {
+        return false;
+    }
+
+    const auto current = now();
+    auto tat           = this->m_tat.load(std::memory_order_relaxed);
+    do {
+        const auto start = std::max(tat, current);
+        if (start - current > this->m_tolerance) {
+            return false;
+        }
+
+        // On failure, tat is reloaded and the decision is made again against the new state
+        if (this->m_tat.compare_exchange_weak(tat, start + this->m_interval, std::memory_order_relaxed)) {
+            return true;
+        }
+    } while (true);
+}
+
+}  // namespace wwa::opentelemetry
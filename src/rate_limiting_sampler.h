@@ -0,0 +1,42 @@
+#ifndef D459EBB6_CA48_4AD8_B86E_B5FD2F42235C
+#define D459EBB6_CA48_4AD8_B86E_B5FD2F42235C
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include <opentelemetry/sdk/trace/sampler.h>
+
+namespace wwa::opentelemetry {
+
+/**
+ * Samples at most `rate` spans per second, allowing bursts of up to one second's worth of spans.
+ *
+ * Admission uses the generic cell rate algorithm: the whole bucket state is a single timestamp (the theoretical
+ * arrival time of the next span), so an admitted span costs one compare-and-swap and a rejected one a single load.
+ */
+class rate_limiting_sampler : public ::opentelemetry::sdk::trace::Sampler {
+public:
+    explicit rate_limiting_sampler(double rate);
+
+    ::opentelemetry::sdk::trace::SamplingResult ShouldSample(
+        const ::opentelemetry::trace::SpanContext& parent_context, ::opentelemetry::trace::TraceId trace_id,
+        ::opentelemetry::nostd::string_view name, ::opentelemetry::trace::SpanKind span_kind,
+        const ::opentelemetry::common::KeyValueIterable& attributes,
+        const ::opentelemetry::trace::SpanContextKeyValueIterable& links
+    ) noexcept override;
+
+    [[nodiscard]] ::opentelemetry::nostd::string_view GetDescription() const noexcept override;
+
+private:
+    std::int64_t m_interval;   // Nanoseconds between two spans at the sustained rate; 0 if nothing is admitted
+    std::int64_t m_tolerance;  // How far ahead of now the theoretical arrival time may run
+    std::atomic<std::int64_t> m_tat{0};
+    std::string m_description;
+
+    bool admit() noexcept;
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* D459EBB6_CA48_4AD8_B86E_B5FD2F42235C */
@@ -0,0 +1,448 @@
+#include "resource_cache.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#    include <iterator>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+#include <opentelemetry/nostd/variant.h>
+#include <opentelemetry/sdk/common/attribute_utils.h>
+
+#include "configurator_p.h"
+
+namespace {
+
+using opentelemetry::sdk::common::OwnedAttributeValue;
+using wwa::opentelemetry::cached_resource_t;
+
+constexpr std::uint32_t cache_magic   = 0x43524F57;  // "WORC"
+constexpr std::uint32_t cache_version = 2;  // 2: per-instance detector keys
+
+constexpr std::chrono::minutes stale_temp_file_age{1};
+
+enum class value_tag : std::uint8_t {
+    boolean,
+    int32,
+    uint32,
+    int64,
+    uint64,
+    float64,
+    string,
+    bool_array,
+    int32_array,
+    uint32_array,
+    int64_array,
+    uint64_array,
+    float64_array,
+    string_array,
+    byte_array,
+};
+
+template<typename T>
+struct tag_of;
+
+// clang-format off
+template<> struct tag_of<bool> { static constexpr auto value = value_tag::boolean; };
+template<> struct tag_of<std::int32_t> { static constexpr auto value = value_tag::int32; };
+template<> struct tag_of<std::uint32_t> { static constexpr auto value = value_tag::uint32; };
+template<> struct tag_of<std::int64_t> { static constexpr auto value = value_tag::int64; };
+template<> struct tag_of<std::uint64_t> { static constexpr auto value = value_tag::uint64; };
+template<> struct tag_of<double> { static constexpr auto value = value_tag::float64; };
+template<> struct tag_of<std::string> { static constexpr auto value = value_tag::string; };
+template<> struct tag_of<std::vector<bool>> { static constexpr auto value = value_tag::bool_array; };
+template<> struct tag_of<std::vector<std::int32_t>> { static constexpr auto value = value_tag::int32_array; };
+template<> struct tag_of<std::vector<std::uint32_t>> { static constexpr auto value = value_tag::uint32_array; };
+template<> struct tag_of<std::vector<std::int64_t>> { static constexpr auto value = value_tag::int64_array; };
+template<> struct tag_of<std::vector<std::uint64_t>> { static constexpr auto value = value_tag::uint64_array; };
+template<> struct tag_of<std::vector<double>> { static constexpr auto value = value_tag::float64_array; };
+template<> struct tag_of<std::vector<std::string>> { static constexpr auto value = value_tag::string_array; };
+template<> struct tag_of<std::vector<std::uint8_t>> { static constexpr auto value = value_tag::byte_array; };
+// clang-format on
+
+class writer {
+public:
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    void put(T value)
+    {
+        this->m_buffer.append(reinterpret_cast<const char*>(&value), sizeof(value));  // NOLINT(*-reinterpret-cast)
+    }
+
+    void put(value_tag tag) { this->put(static_cast<std::uint8_t>(tag)); }
+
+    void put(std::string_view s)
+    {
+        this->put(static_cast<std::uint32_t>(s.size()));
+        this->m_buffer.append(s);
+    }
+
+    template<typename T>
+    void put(const std::vector<T>& v)
+    {
+        this->put(static_cast<std::uint32_t>(v.size()));
+        for (const T& item : v) {
+            this->put(item);
+        }
+    }
+
+    [[nodiscard]] const std::string& buffer() const noexcept { return this->m_buffer; }
+
+private:
+    std::string m_buffer;
+};
+
+class reader {
+public:
+    reader(const char* data, std::size_t size) : m_data(data), m_size(size) {}
+
+    template<typename T>
+        requires std::is_arithmetic_v<T>
+    bool get(T& value)
+    {
+        if (this->m_size - this->m_pos < sizeof(T)) {
+            return false;
+        }
+
+        std::memcpy(&value, this->m_data + this->m_pos, sizeof(T));  // NOLINT(*-pointer-arithmetic)
+        this->m_pos += sizeof(T);
+        return true;
+    }
+
+    bool get(std::string& s)
+    {
+        std::uint32_t len = 0;
+        if (!this->get(len) || this->m_size - this->m_pos < len) {
+            return false;
+        }
+
+        s.assign(this->m_data + this->m_pos, len);  // NOLINT(*-pointer-arithmetic)
+        this->m_pos += len;
+        return true;
+    }
+
+    template<typename T>
+    bool get(std::vector<T>& v)
+    {
+        std::uint32_t count = 0;
+        if (!this->get(count)) {
+            return false;
+        }
+
+        v.clear();
+        for (std::uint32_t i = 0; i < count; ++i) {
+            T item{};
+            if (!this->get(item)) {
+                return false;
+            }
+
+            v.push_back(std::move(item));
+        }
+
+        return true;
+    }
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+    std::size_t m_pos = 0;
+};
+
+template<typename T>
+bool read_value(reader& in, OwnedAttributeValue& value)
+{
+    T v{};
+    if (!in.get(v)) {
+        return false;
+    }
+
+    value = std::move(v);
+    return true;
+}
+
+bool read_value(reader& in, value_tag tag, OwnedAttributeValue& value)
+{
+    switch (tag) {
+        case value_tag::boolean:
+            return read_value<bool>(in, value);
+        case value_tag::int32:
+            return read_value<std::int32_t>(in, value);
+        case value_tag::uint32:
+            return read_value<std::uint32_t>(in, value);
+        case value_tag::int64:
+            return read_value<std::int64_t>(in, value);
+        case value_tag::uint64:
+            return read_value<std::uint64_t>(in, value);
+        case value_tag::float64:
+            return read_value<double>(in, value);
+        case value_tag::string:
+            return read_value<std::string>(in, value);
+        case value_tag::bool_array:
+            return read_value<std::vector<bool>>(in, value);
+        case value_tag::int32_array:
+            return read_value<std::vector<std::int32_t>>(in, value);
+        case value_tag::uint32_array:
+            return read_value<std::vector<std::uint32_t>>(in, value);
+        case value_tag::int64_array:
+            return read_value<std::vector<std::int64_t>>(in, value);
+        case value_tag::uint64_array:
+            return read_value<std::vector<std::uint64_t>>(in, value);
+        case value_tag::float64_array:
+            return read_value<std::vector<double>>(in, value);
+        case value_tag::string_array:
+            return read_value<std::vector<std::string>>(in, value);
+        case value_tag::byte_array:
+            return read_value<std::vector<std::uint8_t>>(in, value);
+    }
+
+    return false;
+}
+
+bool read_entry(reader& in, std::string& key, cached_resource_t& entry)
+{
+    std::int64_t timestamp       = 0;
+    std::uint32_t num_attributes = 0;
+    if (!in.get(key) || !in.get(timestamp) || !in.get(entry.schema_url) || !in.get(num_attributes)) {
+        return false;
+    }
+
+    entry.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(timestamp));
+    for (std::uint32_t i = 0; i < num_attributes; ++i) {
+        std::string name;
+        std::uint8_t tag = 0;
+        OwnedAttributeValue value;
+        if (!in.get(name) || !in.get(tag) || !read_value(in, static_cast<value_tag>(tag), value)) {
+            return false;
+        }
+
+        entry.attributes[name] = std::move(value);
+    }
+
+    return true;
+}
+
+void write_entry(writer& out, const std::string& key, const cached_resource_t& entry)
+{
+    const auto timestamp = std::chrono::duration_cast<std::chrono::seconds>(entry.timestamp.time_since_epoch());
+
+    out.put(key);
+    out.put(static_cast<std::int64_t>(timestamp.count()));
+    out.put(entry.schema_url);
+    out.put(static_cast<std::uint32_t>(entry.attributes.size()));
+    for (const auto& [name, value] : entry.attributes) {
+        out.put(name);
+        opentelemetry::nostd::visit(
+            [&out](const auto& v) {
+                out.put(tag_of<std::decay_t<decltype(v)>>::value);
+                out.put(v);
+            },
+            value
+        );
+    }
+}
+
+/**
+ * Read-only view of the whole cache file: memory-mapped where possible.
+ */
+class file_view {
+public:
+    explicit file_view(const std::string& path)
+    {
+#ifdef _WIN32
+        std::ifstream f(path, std::ios::binary);
+        this->m_contents.assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+        this->m_data = this->m_contents.data();
+        this->m_size = this->m_contents.size();
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT(*-vararg)
+        if (fd == -1) {
+            return;
+        }
+
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            const auto size = static_cast<std::size_t>(st.st_size);
+            if (void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0); addr != MAP_FAILED) {
+                this->m_data = static_cast<const char*>(addr);
+                this->m_size = size;
+            }
+        }
+
+        ::close(fd);
+#endif
+    }
+
+    ~file_view()
+    {
+#ifndef _WIN32
+        if (this->m_data != nullptr) {
+            ::munmap(const_cast<char*>(this->m_data), this->m_size);  // NOLINT(*-const-cast)
+        }
+#endif
+    }
+
+    file_view(const file_view&)            = delete;
+    file_view(file_view&&)                 = delete;
+    file_view& operator=(const file_view&) = delete;
+    file_view& operator=(file_view&&)      = delete;
+
+    [[nodiscard]] const char* data() const noexcept { return this->m_data; }
+    [[nodiscard]] std::size_t size() const noexcept { return this->m_size; }
+
+private:
+    const char* m_data = nullptr;
+    std::size_t m_size = 0;
+#ifdef _WIN32
+    std::string m_contents;
+#endif
+};
+
+std::unordered_map<std::string, cached_resource_t> load(const std::string& path)
+{
+    std::unordered_map<std::string, cached_resource_t> entries;
+
+    const file_view file(path);
+    if (file.data() == nullptr) {
+        return entries;
+    }
+
+    reader in(file.data(), file.size());
+    std::uint32_t magic   = 0;
+    std::uint32_t version = 0;
+    std::uint32_t count   = 0;
+    if (!in.get(magic) || !in.get(version) || !in.get(count) || magic != cache_magic || version != cache_version) {
+        INTERNAL_LOG_WARN(std::format("Resource detector cache <{}> has an unsupported format, ignoring", path));
+        return entries;
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i) {
+        std::string key;
+        cached_resource_t entry;
+        if (!read_entry(in, key, entry)) {
+            INTERNAL_LOG_WARN(std::format("Resource detector cache <{}> is truncated, ignoring the rest", path));
+            break;
+        }
+
+        entries.insert_or_assign(std::move(key), std::move(entry));
+    }
+
+    return entries;
+}
+
+/**
+ * Removes the temporary files left behind by processes that died between writing and renaming them. A file is only
+ * considered abandoned once it is old enough for no writer to still be working on it.
+ */
+void remove_stale_temp_files(const std::string& path)
+{
+    const std::filesystem::path cache_path(path);
+    const auto prefix = cache_path.filename().string() + '.';
+    const auto cutoff = std::filesystem::file_time_type::clock::now() - stale_temp_file_age;
+
+    std::error_code ec;
+    auto dir = cache_path.parent_path();
+    for (std::filesystem::directory_iterator it(dir.empty() ? "." : dir, ec), end; !ec && it != end; it.increment(ec)) {
+        const auto name = it->path().filename().string();
+        if (name.size() <= prefix.size() || !name.starts_with(prefix) ||
+            name.find_first_not_of("0123456789abcdef", prefix.size()) != std::string::npos) {
+            continue;
+        }
+
+        std::error_code file_ec;
+        if (const auto mtime = it->last_write_time(file_ec); !file_ec && mtime < cutoff) {
+            std::filesystem::remove(it->path(), file_ec);
+        }
+    }
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+resource_cache::resource_cache(std::string path) : m_path(std::move(path)), m_entries(load(this->m_path)) {}
+
+std::optional<cached_resource_t> resource_cache::get(const std::string& key) const
+{
+    if (const auto it = this->m_entries.find(key); it != this->m_entries.end()) {
+        return it->second;
+    }
+
+    return std::nullopt;
+}
+
+void resource_cache::put(const std::string& key, const detected_resource_t& resource)
+{
+    cached_resource_t entry;
+    entry.attributes = resource.attributes;
+    entry.schema_url = resource.schema_url;
+    entry.timestamp  = std::chrono::system_clock::now();
+
+    this->m_entries.insert_or_assign(key, entry);
+    this->m_pending.insert_or_assign(key, std::move(entry));
+}
+
+bool resource_cache::save()
+{
+    if (this->m_pending.empty()) {
+        return true;
+    }
+
+    // Another process may have updated the file since we loaded it; do not lose its entries
+    auto entries = load(this->m_path);
+    for (const auto& [key, entry] : this->m_pending) {
+        entries.insert_or_assign(key, entry);
+    }
+
+    writer out;
+    out.put(cache_magic);
+    out.put(cache_version);
+    out.put(static_cast<std::uint32_t>(entries.size()));
+    for (const auto& [key, entry] : entries) {
+        write_entry(out, key, entry);
+    }
+
+    std::random_device rd;
+    const auto tmp_path = std::format("{}.{:x}", this->m_path, (static_cast<std::uint64_t>(rd()) << 32U) | rd());
+    {
+        std::ofstream f(tmp_path, std::ios::binary | std::ios::trunc);
+        f.write(out.buffer().data(), static_cast<std::streamsize>(out.buffer().size()));
+        if (!f) {
+            INTERNAL_LOG_WARN(std::format("Failed to write resource detector cache <{}>", tmp_path));
+            std::error_code ec;
+            std::filesystem::remove(tmp_path, ec);
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, this->m_path, ec);
+    if (ec) {
+        INTERNAL_LOG_WARN(
+            std::format("Failed to replace resource detector cache <{}>: {}", this->m_path, ec.message())
+        );
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+
+    this->m_pending.clear();
+    remove_stale_temp_files(this->m_path);
+    return true;
+}
+
+}  // namespace wwa::opentelemetry
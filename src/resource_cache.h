@@ -0,0 +1,45 @@
+#ifndef A3E9C1D7_6B2F_4A85_9D4E_7C1B5F0E2A96
+#define A3E9C1D7_6B2F_4A85_9D4E_7C1B5F0E2A96
+
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include <opentelemetry/sdk/resource/resource.h>
+
+namespace wwa::opentelemetry {
+
+struct detected_resource_t {
+    ::opentelemetry::sdk::resource::ResourceAttributes attributes;
+    std::string schema_url;
+};
+
+struct cached_resource_t : detected_resource_t {
+    std::chrono::system_clock::time_point timestamp;
+};
+
+/**
+ * File-backed cache of resource detector results, shared by all processes using the same path.
+ *
+ * The file is memory-mapped and parsed once on construction. Updates are buffered by `put()`;
+ * `save()` merges them into the current contents of the file and atomically replaces it,
+ * so that concurrent readers never observe a partially written file.
+ */
+class resource_cache {
+public:
+    explicit resource_cache(std::string path);
+
+    [[nodiscard]] std::optional<cached_resource_t> get(const std::string& key) const;
+    void put(const std::string& key, const detected_resource_t& resource);
+    bool save();
+
+private:
+    std::string m_path;
+    std::unordered_map<std::string, cached_resource_t> m_entries;
+    std::unordered_map<std::string, cached_resource_t> m_pending;
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* A3E9C1D7_6B2F_4A85_9D4E_7C1B5F0E2A96 */
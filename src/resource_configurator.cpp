@@ -1,5 +1,15 @@
+#include <chrono>
+#include <exception>
+#include <format>
+#include <future>
+#include <memory>
+#include <optional>
 #include <string>
+#include <thread>
+#include <typeinfo>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <opentelemetry/sdk/resource/resource.h>
 #include <opentelemetry/sdk/resource/resource_detector.h>
@@ -10,10 +20,15 @@
 #    include <opentelemetry/semconv/service_attributes.h>
 #endif
 
+#include "configurator_p.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "resource_cache.h"
 
 namespace {
 
+using detector_t = std::shared_ptr<opentelemetry::sdk::resource::ResourceDetector>;
+using wwa::opentelemetry::detected_resource_t;
+
 /**
  * Unlike Node.JS SDK, C++ SDK does not overwrite the attributes of the left-hand side with the right-hand side.
  */
@@ -26,6 +41,177 @@ void merge_attributes(
     }
 }
 
+std::string get_detector_name(const detector_t& detector)
+{
+    const auto& detector_ref = *detector;
+    return typeid(detector_ref).name();
+}
+
+std::vector<std::string> get_cache_keys(const wwa::opentelemetry::resource_config_t& opts)
+{
+    std::vector<std::string> keys;
+    keys.reserve(opts.detectors.size());
+
+    // Detectors of the same type may be configured differently: tell them apart by their position
+    std::unordered_map<std::string, std::size_t> ordinals;
+    for (std::size_t i = 0; i < opts.detectors.size(); ++i) {
+        if (i < opts.detector_cache_keys.size() && !opts.detector_cache_keys[i].empty()) {
+            keys.push_back(opts.detector_cache_keys[i]);
+        }
+        else {
+            const auto name = get_detector_name(opts.detectors[i]);
+            keys.push_back(std::format("{}#{}", name, ordinals[name]++));
+        }
+    }
+
+    return keys;
+}
+
+/**
+ * A detector that throws is skipped like one that misses its deadline, so that its stale cache entry can be used.
+ */
+std::optional<detected_resource_t> detect(const detector_t& detector)
+{
+    try {
+        const auto res = detector->Detect();
+        return detected_resource_t{res.GetAttributes(), res.GetSchemaURL()};
+    }
+    catch (const std::exception& e) {
+        INTERNAL_LOG_WARN(
+            std::format("Resource detector {} failed, skipping: {}", get_detector_name(detector), e.what())
+        );
+    }
+    catch (...) {
+        INTERNAL_LOG_WARN(std::format("Resource detector {} failed, skipping", get_detector_name(detector)));
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * With a deadline, the detector runs on a detached thread: a detector that misses its deadline cannot be cancelled,
+ * and we must not wait for it. The thread owns the detector, so it can safely outlive the caller.
+ * Without one, we wait for the detector anyway, so it runs on a thread joined by the future.
+ */
+std::future<std::optional<detected_resource_t>> launch_detector(const detector_t& detector, bool detached)
+{
+    if (!detached) {
+        return std::async(std::launch::async, [detector]() { return detect(detector); });
+    }
+
+    std::packaged_task<std::optional<detected_resource_t>()> task([detector]() { return detect(detector); });
+    auto future = task.get_future();
+    std::thread(std::move(task)).detach();
+    return future;
+}
+
+std::optional<detected_resource_t> await_detector(
+    std::size_t index, const detector_t& detector, std::future<std::optional<detected_resource_t>>& future,
+    std::optional<std::chrono::steady_clock::time_point> deadline
+)
+{
+    if (deadline && future.wait_until(*deadline) != std::future_status::ready) {
+        INTERNAL_LOG_WARN(
+            std::format("Resource detector #{} ({}) timed out, skipping", index, get_detector_name(detector))
+        );
+        return std::nullopt;
+    }
+
+    return future.get();
+}
+
+void run_detectors(
+    const wwa::opentelemetry::resource_config_t& opts, const std::vector<std::size_t>& indices,
+    std::vector<std::optional<detected_resource_t>>& results
+)
+{
+    using std::chrono::steady_clock;
+
+    const bool has_deadline = opts.detector_timeout.count() > 0 || opts.detection_timeout.count() > 0;
+    if (indices.size() == 1 && !has_deadline) {
+        results[indices.front()] = detect(opts.detectors[indices.front()]);
+        return;
+    }
+
+    const auto start = steady_clock::now();
+    std::optional<steady_clock::time_point> deadline;
+    if (opts.detection_timeout.count() > 0) {
+        deadline = start + opts.detection_timeout;
+    }
+
+    if (opts.detector_timeout.count() > 0 && (!deadline || start + opts.detector_timeout < *deadline)) {
+        // All detectors start at the same time, so the per-detector deadline is the same for all of them
+        deadline = start + opts.detector_timeout;
+    }
+
+    std::vector<std::future<std::optional<detected_resource_t>>> futures;
+    futures.reserve(indices.size());
+    for (const auto idx : indices) {
+        futures.push_back(launch_detector(opts.detectors[idx], deadline.has_value()));
+    }
+
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        const auto idx = indices[i];
+        results[idx]   = await_detector(idx, opts.detectors[idx], futures[i], deadline);
+    }
+}
+
+/**
+ * Returns the detection results in declaration order, so that the merge order (and thus the result) is deterministic.
+ *
+ * Stale cache entries are refreshed right away, like missing ones, with the same deadlines; a detector that fails
+ * or misses its deadline falls back on its stale entry. Nothing keeps running in the background to update the cache.
+ */
+std::vector<std::optional<detected_resource_t>> detect_resources(const wwa::opentelemetry::resource_config_t& opts)
+{
+    std::vector<std::optional<detected_resource_t>> results(opts.detectors.size());
+    std::vector<std::optional<detected_resource_t>> stale(opts.detectors.size());
+    std::vector<std::size_t> indices;
+    indices.reserve(opts.detectors.size());
+
+    std::optional<wwa::opentelemetry::resource_cache> cache;
+    std::vector<std::string> keys;
+    if (!opts.detector_cache_path.empty()) {
+        cache.emplace(opts.detector_cache_path);
+        keys = get_cache_keys(opts);
+    }
+
+    const auto now = std::chrono::system_clock::now();
+    for (std::size_t i = 0; i < opts.detectors.size(); ++i) {
+        if (cache) {
+            if (auto entry = cache->get(keys[i]); entry) {
+                auto& slot = now - entry->timestamp > opts.detector_cache_ttl ? stale[i] : results[i];
+                slot       = detected_resource_t{std::move(entry->attributes), std::move(entry->schema_url)};
+                if (results[i]) {
+                    continue;
+                }
+            }
+        }
+
+        indices.push_back(i);
+    }
+
+    if (!indices.empty()) {
+        run_detectors(opts, indices, results);
+    }
+
+    if (cache) {
+        for (const auto idx : indices) {
+            if (results[idx]) {
+                cache->put(keys[idx], *results[idx]);
+            }
+            else if (stale[idx]) {
+                INTERNAL_LOG_WARN(std::format("Using the stale cached result of resource detector #{}", idx));
+                results[idx] = std::move(stale[idx]);
+            }
+        }
+
+        cache->save();
+    }
+
+    return results;
+}
+
 }  // namespace
 
 namespace wwa::opentelemetry {
@@ -39,11 +225,14 @@ namespace wwa::opentelemetry {
 #endif
     ::opentelemetry::sdk::resource::ResourceAttributes attributes;
     std::string schema_url = opts.schema_url;
-    for (const auto& detector : opts.detectors) {
-        const auto res = detector->Detect();
-        merge_attributes(attributes, res.GetAttributes());
-        if (!res.GetSchemaURL().empty()) {
-            schema_url = res.GetSchemaURL();
+    for (const auto& res : detect_resources(opts)) {
+        if (!res) {
+            continue;
+        }
+
+        merge_attributes(attributes, res->attributes);
+        if (!res->schema_url.empty()) {
+            schema_url = res->schema_url;
         }
     }
 
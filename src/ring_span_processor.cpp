@@ -0,0 +1,160 @@
+#include "ring_span_processor.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "fanout_exporter.h"
+#include "queue_stats.h"
+
+namespace {
+
+void drop_span(const wwa::opentelemetry::batching_options_t& options) noexcept
+{
+    if (options.stats) {
+        options.stats->dropped.add();
+    }
+
+    wwa::opentelemetry::log_batching_warning("Ring span processor queue is full - dropping span.");
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+ring_span_processor::ring_span_processor(
+    std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>> exporters,
+    const batching_options_t& options, std::shared_ptr<export_scheduler> scheduler
+)
+    : m_options(options), m_queue(options.max_queue_size),
+      m_dispatcher(
+          is_byte_limited(options) ? make_sized_exporters(std::move(exporters)) : std::move(exporters), options,
+          "spans", [this]() { this->m_worker.notify(); }
+      ),
+      m_worker(options.schedule_delay, [this](bool block) { return this->export_queue(block); }, std::move(scheduler))
+{
+    this->m_options.max_export_batch_size = std::max<std::size_t>(this->m_options.max_export_batch_size, 1);
+    this->m_batch.reserve(this->m_options.max_export_batch_size);
+    this->m_worker.start();
+}
+
+ring_span_processor::~ring_span_processor()
+{
+    if (!this->m_worker.is_stopped()) {
+        this->Shutdown(std::chrono::microseconds::max());
+    }
+}
+
+std::unique_ptr<::opentelemetry::sdk::trace::Recordable> ring_span_processor::MakeRecordable() noexcept
+{
+    return this->m_dispatcher.exporter().MakeRecordable();
+}
+
+void ring_span_processor::OnStart(
+    ::opentelemetry::sdk::trace::Recordable&, const ::opentelemetry::trace::SpanContext&
+) noexcept
+{
+}
+
+void ring_span_processor::OnEnd(std::unique_ptr<::opentelemetry::sdk::trace::Recordable>&& span) noexcept
+{
+    if (this->m_worker.is_stopped()) {
+        return;
+    }
+
+    std::size_t bytes    = 0;
+    bool bytes_half_full = false;
+    if (this->m_options.max_queue_bytes != 0) {
+        // Reserve the bytes first, so that concurrent producers cannot overshoot the limit
+        bytes             = recordable_size(*span);
+        const auto queued = this->m_queued_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        if (queued > this->m_options.max_queue_bytes) {
+            this->m_queued_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+            drop_span(this->m_options);
+            return;
+        }
+
+        bytes_half_full = queued >= this->m_options.max_queue_bytes / 2;
+    }
+
+    if (!this->m_queue.push(span)) {
+        if (bytes != 0) {
+            this->m_queued_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        drop_span(this->m_options);
+        return;
+    }
+
+    if (this->m_options.stats) {
+        this->m_options.stats->enqueued.add();
+    }
+
+    // Like BatchSpanProcessor, start an export cycle early when the queue is half full or holds a full batch
+    const auto size = this->m_queue.size();
+    if (size >= this->m_options.max_queue_size / 2 || size >= this->m_options.max_export_batch_size ||
+        bytes_half_full) {
+        this->m_worker.notify();
+    }
+}
+
+bool ring_span_processor::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_worker.force_flush(timeout) && this->m_dispatcher.wait(timeout);
+}
+
+bool ring_span_processor::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    if (!this->m_worker.stop()) {
+        return true;
+    }
+
+    return this->m_dispatcher.shutdown(timeout);
+}
+
+bool ring_span_processor::export_queue(bool block)
+{
+    auto& batch = this->m_batch;
+    while (true) {
+        // A batch that found no free export slot in the previous cycle goes first
+        if (batch.empty()) {
+            std::size_t batch_bytes = 0;
+            while (batch.size() < this->m_options.max_export_batch_size) {
+                auto span = this->m_carry ? std::move(this->m_carry) : this->m_queue.pop();
+                if (!span) {
+                    break;
+                }
+
+                if (is_byte_limited(this->m_options)) {
+                    const auto bytes = recordable_size(*span);
+                    if (this->m_options.max_export_batch_bytes != 0 && !batch.empty() &&
+                        batch_bytes + bytes > this->m_options.max_export_batch_bytes) {
+                        // Does not fit: starts the next batch
+                        this->m_carry = std::move(span);
+                        break;
+                    }
+
+                    batch_bytes += bytes;
+                    if (this->m_options.max_queue_bytes != 0) {
+                        this->m_queued_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+                    }
+                }
+
+                batch.push_back(std::move(span));
+            }
+
+            if (batch.empty()) {
+                return true;
+            }
+
+            if (this->m_options.stats) {
+                this->m_options.stats->dequeued.fetch_add(batch.size(), std::memory_order_relaxed);
+            }
+        }
+
+        if (!this->m_dispatcher.submit(batch, block)) {
+            return false;
+        }
+    }
+}
+
+}  // namespace wwa::opentelemetry
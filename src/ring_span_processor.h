@@ -0,0 +1,66 @@
+#ifndef D2F7B4A9_8E3C_4D61_A0B5_6C9E1F3A7D24
+#define D2F7B4A9_8E3C_4D61_A0B5_6C9E1F3A7D24
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <opentelemetry/sdk/trace/exporter.h>
+#include <opentelemetry/sdk/trace/processor.h>
+#include <opentelemetry/sdk/trace/recordable.h>
+
+#include "batching.h"
+#include "bounded_queue.h"
+#include "export_dispatcher.h"
+#include "export_scheduler.h"
+
+namespace wwa::opentelemetry {
+
+/**
+ * Drop-in replacement for the SDK BatchSpanProcessor, with the span queue built on a lock-free bounded ring.
+ *
+ * The behavior mirrors BatchSpanProcessor: a span that does not fit in the queue is dropped, the worker is woken
+ * up once the queue is half full or holds a full batch, and otherwise exports every `schedule_delay`,
+ * draining the queue in batches of at most `max_export_batch_size` spans.
+ */
+class ring_span_processor : public ::opentelemetry::sdk::trace::SpanProcessor {
+public:
+    // `exporters`: instances of the same exporter, one per export slot
+    ring_span_processor(
+        std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>> exporters,
+        const batching_options_t& options, std::shared_ptr<export_scheduler> scheduler = nullptr
+    );
+
+    ring_span_processor(const ring_span_processor&)            = delete;
+    ring_span_processor& operator=(const ring_span_processor&) = delete;
+    ring_span_processor(ring_span_processor&&)                 = delete;
+    ring_span_processor& operator=(ring_span_processor&&)      = delete;
+    ~ring_span_processor() override;
+
+    std::unique_ptr<::opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
+    void OnStart(
+        ::opentelemetry::sdk::trace::Recordable& span, const ::opentelemetry::trace::SpanContext& parent_context
+    ) noexcept override;
+    void OnEnd(std::unique_ptr<::opentelemetry::sdk::trace::Recordable>&& span) noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+private:
+    batching_options_t m_options;
+    bounded_queue<::opentelemetry::sdk::trace::Recordable> m_queue;
+    std::atomic<std::size_t> m_queued_bytes{0};  // Only maintained with max_queue_bytes
+    // Only used by the worker: the batch being built (or waiting for a free export slot), and the span that did not
+    // fit in the previous batch
+    std::vector<std::unique_ptr<::opentelemetry::sdk::trace::Recordable>> m_batch;
+    std::unique_ptr<::opentelemetry::sdk::trace::Recordable> m_carry;
+    export_dispatcher<::opentelemetry::sdk::trace::Recordable, ::opentelemetry::sdk::trace::SpanExporter> m_dispatcher;
+    batch_worker m_worker;
+
+    bool export_queue(bool block);
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* D2F7B4A9_8E3C_4D61_A0B5_6C9E1F3A7D24 */
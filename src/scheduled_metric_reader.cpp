@@ -0,0 +1,115 @@
+#include "scheduled_metric_reader.h"
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <utility>
+
+#include <opentelemetry/sdk/metrics/export/metric_producer.h>
+
+#include "configurator_p.h"
+
+namespace {
+
+std::chrono::steady_clock::time_point deadline_after(std::chrono::microseconds timeout) noexcept
+{
+    // ForceFlush() defaults to microseconds::max(), which does not fit in a time point
+    const auto now = std::chrono::steady_clock::now();
+    if (timeout >= std::chrono::duration_cast<std::chrono::microseconds>(
+                       std::chrono::steady_clock::time_point::max() - now
+                   )) {
+        return std::chrono::steady_clock::time_point::max();
+    }
+
+    return now + timeout;
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+scheduled_metric_reader::scheduled_metric_reader(
+    std::unique_ptr<::opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+    std::chrono::milliseconds export_interval, std::chrono::milliseconds export_timeout,
+    std::shared_ptr<export_scheduler> scheduler
+)
+    : m_exporter(std::move(exporter)), m_export_interval(export_interval), m_export_timeout(export_timeout),
+      m_scheduler(std::move(scheduler))
+{
+}
+
+scheduled_metric_reader::~scheduled_metric_reader()
+{
+    // No-op if the reader has been shut down
+    this->m_scheduler->cancel(this->m_task);
+}
+
+::opentelemetry::sdk::metrics::AggregationTemporality scheduled_metric_reader::GetAggregationTemporality(
+    ::opentelemetry::sdk::metrics::InstrumentType instrument_type
+) const noexcept
+{
+    return this->m_exporter->GetAggregationTemporality(instrument_type);
+}
+
+bool scheduled_metric_reader::OnForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    const auto flush_deadline = deadline_after(timeout);
+    const bool result = this->collect_and_export(std::min(flush_deadline, deadline_after(this->m_export_timeout)));
+
+    if (flush_deadline == std::chrono::steady_clock::time_point::max()) {
+        return this->m_exporter->ForceFlush(timeout) && result;
+    }
+
+    const auto remaining = flush_deadline - std::chrono::steady_clock::now();
+    return remaining > remaining.zero() &&
+           this->m_exporter->ForceFlush(std::chrono::duration_cast<std::chrono::microseconds>(remaining)) && result;
+}
+
+bool scheduled_metric_reader::OnShutDown(std::chrono::microseconds timeout) noexcept
+{
+    this->m_scheduler->cancel(this->m_task);
+    return this->m_exporter->Shutdown(timeout);
+}
+
+void scheduled_metric_reader::OnInitialized() noexcept
+{
+    // The metric producer is set by now
+    try {
+        this->m_task = this->m_scheduler->schedule(
+            [this]() { this->collect_and_export(deadline_after(this->m_export_timeout)); }, this->m_export_interval
+        );
+    }
+    catch (const std::exception&) {  // NOLINT(bugprone-empty-catch)
+        // Metrics are still exported on ForceFlush()
+    }
+}
+
+bool scheduled_metric_reader::collect_and_export(std::chrono::steady_clock::time_point deadline) noexcept
+{
+    try {
+        std::unique_lock lock(this->m_mutex, std::defer_lock);
+        if (deadline == std::chrono::steady_clock::time_point::max()) {
+            lock.lock();
+        }
+        else if (!lock.try_lock_until(deadline)) {
+            // A scheduled collection is still running
+            return false;
+        }
+
+        return this->Collect([this, deadline](::opentelemetry::sdk::metrics::ResourceMetrics& metrics) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                INTERNAL_LOG_WARN("Scheduled metric reader: collection exceeded the export timeout - skipping export");
+                return false;
+            }
+
+            // As in PeriodicExportingMetricReader, the exporter reports its own failures
+            this->m_exporter->Export(metrics);
+            return true;
+        });
+    }
+    catch (const std::system_error&) {
+        return false;
+    }
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,57 @@
+#ifndef A8D3F6B2_1C7E_4B94_8E5A_3F0C9D2B6E71
+#define A8D3F6B2_1C7E_4B94_8E5A_3F0C9D2B6E71
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+#include <opentelemetry/sdk/metrics/instruments.h>
+#include <opentelemetry/sdk/metrics/metric_reader.h>
+#include <opentelemetry/sdk/metrics/push_metric_exporter.h>
+
+#include "export_scheduler.h"
+
+namespace wwa::opentelemetry {
+
+/**
+ * PeriodicExportingMetricReader running its collections on the shared export scheduler.
+ *
+ * Collection and export run on a scheduler thread, `export_interval` after the previous collection completes.
+ * Like in PeriodicExportingMetricReader, the export is skipped when the collection has used up `export_timeout`;
+ * `ForceFlush()` gives up once its own timeout expires.
+ */
+class scheduled_metric_reader : public ::opentelemetry::sdk::metrics::MetricReader {
+public:
+    scheduled_metric_reader(
+        std::unique_ptr<::opentelemetry::sdk::metrics::PushMetricExporter> exporter,
+        std::chrono::milliseconds export_interval, std::chrono::milliseconds export_timeout,
+        std::shared_ptr<export_scheduler> scheduler
+    );
+
+    scheduled_metric_reader(const scheduled_metric_reader&)            = delete;
+    scheduled_metric_reader& operator=(const scheduled_metric_reader&) = delete;
+    scheduled_metric_reader(scheduled_metric_reader&&)                 = delete;
+    scheduled_metric_reader& operator=(scheduled_metric_reader&&)      = delete;
+    ~scheduled_metric_reader() override;
+
+    ::opentelemetry::sdk::metrics::AggregationTemporality
+    GetAggregationTemporality(::opentelemetry::sdk::metrics::InstrumentType instrument_type) const noexcept override;
+
+private:
+    std::unique_ptr<::opentelemetry::sdk::metrics::PushMetricExporter> m_exporter;
+    std::chrono::milliseconds m_export_interval;
+    std::chrono::milliseconds m_export_timeout;
+    std::shared_ptr<export_scheduler> m_scheduler;
+    export_scheduler::task_id_t m_task = 0;
+    std::timed_mutex m_mutex;  // Serializes scheduled collections and ForceFlush()
+
+    bool OnForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool OnShutDown(std::chrono::microseconds timeout) noexcept override;
+    void OnInitialized() noexcept override;
+
+    bool collect_and_export(std::chrono::steady_clock::time_point deadline) noexcept;
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* A8D3F6B2_1C7E_4B94_8E5A_3F0C9D2B6E71 */
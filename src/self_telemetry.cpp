@@ -0,0 +1,241 @@
+#include "self_telemetry.h"
+
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <opentelemetry/context/context.h>
+#include <opentelemetry/metrics/async_instruments.h>
+#include <opentelemetry/metrics/meter.h>
+#include <opentelemetry/metrics/observer_result.h>
+#include <opentelemetry/metrics/sync_instruments.h>
+#include <opentelemetry/nostd/shared_ptr.h>
+#include <opentelemetry/nostd/unique_ptr.h>
+#include <opentelemetry/nostd/variant.h>
+
+#include "queue_stats.h"
+
+namespace {
+
+using wwa::opentelemetry::exporter_telemetry_t;
+using wwa::opentelemetry::get_queue_stats;
+using wwa::opentelemetry::queue_stats_t;
+
+struct exporter_telemetry_registry_t {
+    std::mutex mutex;
+    std::vector<std::weak_ptr<exporter_telemetry_t>> entries;
+};
+
+exporter_telemetry_registry_t& exporter_telemetry_registry()
+{
+    static exporter_telemetry_registry_t instance;
+    return instance;
+}
+
+std::vector<std::shared_ptr<exporter_telemetry_t>> get_exporter_telemetry()
+{
+    std::vector<std::shared_ptr<exporter_telemetry_t>> result;
+
+    auto& registry = exporter_telemetry_registry();
+    const std::lock_guard lock(registry.mutex);
+    result.reserve(registry.entries.size());
+    for (const auto& entry : registry.entries) {
+        if (auto telemetry = entry.lock(); telemetry) {
+            result.push_back(std::move(telemetry));
+        }
+    }
+
+    return result;
+}
+
+struct self_telemetry_state_t {
+    using instrument_t = opentelemetry::nostd::shared_ptr<opentelemetry::metrics::ObservableInstrument>;
+
+    std::mutex mutex;
+    opentelemetry::nostd::shared_ptr<opentelemetry::metrics::Meter> meter;
+    std::vector<std::pair<instrument_t, opentelemetry::metrics::ObservableCallbackPtr>> instruments;
+    opentelemetry::nostd::unique_ptr<opentelemetry::metrics::Histogram<std::uint64_t>> batch_size;
+    opentelemetry::nostd::unique_ptr<opentelemetry::metrics::Histogram<double>> duration;
+};
+
+self_telemetry_state_t& self_telemetry_state()
+{
+    static self_telemetry_state_t instance;
+    return instance;
+}
+
+template<typename T, typename F>
+void observe(
+    opentelemetry::metrics::ObserverResult& result, const std::vector<std::shared_ptr<T>>& entries, F&& value
+)
+{
+    using observer_t = opentelemetry::nostd::shared_ptr<opentelemetry::metrics::ObserverResultT<std::int64_t>>;
+    if (!opentelemetry::nostd::holds_alternative<observer_t>(result)) {
+        return;
+    }
+
+    auto& observer = opentelemetry::nostd::get<observer_t>(result);
+    for (const auto& entry : entries) {
+        observer->Observe(
+            static_cast<std::int64_t>(value(*entry)),
+            {{"signal", opentelemetry::nostd::string_view(entry->signal)},
+             {"exporter", opentelemetry::nostd::string_view(entry->exporter)}}
+        );
+    }
+}
+
+void observe_queue_size(opentelemetry::metrics::ObserverResult result, void*)
+{
+    observe(result, get_queue_stats(), [](const queue_stats_t& stats) { return stats.pending(); });
+}
+
+void observe_queue_capacity(opentelemetry::metrics::ObserverResult result, void*)
+{
+    observe(result, get_queue_stats(), [](const queue_stats_t& stats) { return stats.capacity; });
+}
+
+void observe_dropped(opentelemetry::metrics::ObserverResult result, void*)
+{
+    observe(result, get_queue_stats(), [](const queue_stats_t& stats) { return stats.dropped.load(); });
+}
+
+void observe_exported(opentelemetry::metrics::ObserverResult result, void*)
+{
+    observe(result, get_exporter_telemetry(), [](const exporter_telemetry_t& telemetry) {
+        return telemetry.exported.load(std::memory_order_relaxed);
+    });
+}
+
+void observe_exports(opentelemetry::metrics::ObserverResult result, void*)
+{
+    observe(result, get_exporter_telemetry(), [](const exporter_telemetry_t& telemetry) {
+        return telemetry.exports.load(std::memory_order_relaxed);
+    });
+}
+
+void observe_failures(opentelemetry::metrics::ObserverResult result, void*)
+{
+    observe(result, get_exporter_telemetry(), [](const exporter_telemetry_t& telemetry) {
+        return telemetry.failures.load(std::memory_order_relaxed);
+    });
+}
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+std::shared_ptr<exporter_telemetry_t> make_exporter_telemetry(const std::string& signal, const std::string& exporter)
+{
+    auto& registry = exporter_telemetry_registry();
+    const std::lock_guard lock(registry.mutex);
+    std::erase_if(registry.entries, [](const auto& entry) { return entry.expired(); });
+
+    // The instances of an exporter (one per export slot) share their counters: they report the same time series
+    for (const auto& entry : registry.entries) {
+        auto telemetry = entry.lock();
+        if (telemetry && telemetry->signal == signal && telemetry->exporter == exporter) {
+            return telemetry;
+        }
+    }
+
+    auto telemetry      = std::make_shared<exporter_telemetry_t>();
+    telemetry->signal   = signal;
+    telemetry->exporter = exporter;
+    registry.entries.push_back(telemetry);
+    return telemetry;
+}
+
+void record_export(
+    exporter_telemetry_t& telemetry, std::size_t items, std::chrono::steady_clock::duration duration, bool success
+) noexcept
+{
+    telemetry.exported.fetch_add(items, std::memory_order_relaxed);
+    telemetry.exports.fetch_add(1, std::memory_order_relaxed);
+    if (!success) {
+        telemetry.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    try {
+        auto& state = self_telemetry_state();
+        const std::lock_guard lock(state.mutex);
+        const ::opentelemetry::context::Context context;
+        if (state.batch_size) {
+            state.batch_size->Record(
+                items,
+                {{"signal", ::opentelemetry::nostd::string_view(telemetry.signal)},
+                 {"exporter", ::opentelemetry::nostd::string_view(telemetry.exporter)}},
+                context
+            );
+        }
+
+        if (state.duration) {
+            state.duration->Record(
+                std::chrono::duration<double, std::milli>(duration).count(),
+                {{"signal", ::opentelemetry::nostd::string_view(telemetry.signal)},
+                 {"exporter", ::opentelemetry::nostd::string_view(telemetry.exporter)},
+                 {"success", success}},
+                context
+            );
+        }
+    }
+    catch (const std::system_error&) {  // NOLINT(bugprone-empty-catch)
+    }
+}
+
+void enable_self_telemetry(::opentelemetry::metrics::MeterProvider& provider)
+{
+    auto meter = provider.GetMeter("wwa.opentelemetry.configurator");
+    if (!meter) {
+        return;
+    }
+
+    using callback_t = ::opentelemetry::metrics::ObservableCallbackPtr;
+    std::vector<std::pair<self_telemetry_state_t::instrument_t, callback_t>> instruments{
+        {meter->CreateInt64ObservableUpDownCounter(
+             "otel.sdk.processor.queue.size", "Number of items in the queue of the batching processor", "{item}"
+         ),
+         observe_queue_size},
+        {meter->CreateInt64ObservableUpDownCounter(
+             "otel.sdk.processor.queue.capacity", "Maximum number of items in the queue of the batching processor",
+             "{item}"
+         ),
+         observe_queue_capacity},
+        {meter->CreateInt64ObservableCounter(
+             "otel.sdk.processor.items.dropped", "Number of items dropped by the batching processor", "{item}"
+         ),
+         observe_dropped},
+        {meter->CreateInt64ObservableCounter(
+             "otel.sdk.exporter.items.exported", "Number of items passed to the exporter", "{item}"
+         ),
+         observe_exported},
+        {meter->CreateInt64ObservableCounter("otel.sdk.exporter.exports", "Number of exports", "{export}"),
+         observe_exports},
+        {meter->CreateInt64ObservableCounter(
+             "otel.sdk.exporter.export.failures", "Number of failed exports", "{export}"
+         ),
+         observe_failures},
+    };
+
+    std::erase_if(instruments, [](const auto& entry) { return !entry.first; });
+    for (const auto& [instrument, callback] : instruments) {
+        instrument->AddCallback(callback, nullptr);
+    }
+
+    auto batch_size =
+        meter->CreateUInt64Histogram("otel.sdk.exporter.batch.size", "Number of items per export", "{item}");
+    auto duration = meter->CreateDoubleHistogram("otel.sdk.exporter.operation.duration", "Duration of exports", "ms");
+
+    auto& state = self_telemetry_state();
+    const std::lock_guard lock(state.mutex);
+    for (auto& [instrument, callback] : state.instruments) {
+        instrument->RemoveCallback(callback, nullptr);
+    }
+
+    state.meter       = std::move(meter);
+    state.instruments = std::move(instruments);
+    state.batch_size  = std::move(batch_size);
+    state.duration    = std::move(duration);
+}
+
+}  // namespace wwa::opentelemetry
@@ -0,0 +1,40 @@
+#ifndef C2E6A9D4_5B1F_4C73_A8E2_9D4B7F0C3A15
+#define C2E6A9D4_5B1F_4C73_A8E2_9D4B7F0C3A15
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <opentelemetry/metrics/meter_provider.h>
+
+namespace wwa::opentelemetry {
+
+// Statistics of an exporter; updated once per export
+struct exporter_telemetry_t {
+    std::string signal;
+    std::string exporter;
+    std::atomic<std::uint64_t> exported{0};
+    std::atomic<std::uint64_t> exports{0};
+    std::atomic<std::uint64_t> failures{0};
+};
+
+// Exporters with the same signal and name share their counters
+std::shared_ptr<exporter_telemetry_t> make_exporter_telemetry(const std::string& signal, const std::string& exporter);
+
+// Updates the counters and, once self-telemetry is enabled, the batch size and export duration histograms
+void record_export(
+    exporter_telemetry_t& telemetry, std::size_t items, std::chrono::steady_clock::duration duration, bool success
+) noexcept;
+
+/**
+ * Publishes the statistics of all processors (see queue_stats_t) and exporters through `provider`: observable
+ * instruments read the counters at collection time. Replaces the instruments created by a previous call.
+ */
+void enable_self_telemetry(::opentelemetry::metrics::MeterProvider& provider);
+
+}  // namespace wwa::opentelemetry
+
+#endif /* C2E6A9D4_5B1F_4C73_A8E2_9D4B7F0C3A15 */
@@ -0,0 +1,82 @@
+#include "sharded_processor.h"
+
+#include <thread>
+
+namespace wwa::opentelemetry {
+
+std::size_t get_shard_count(std::size_t max_queue_size) noexcept
+{
+    // hardware_concurrency() may return 0 if the value is not computable; every shard should hold at least one item
+    const std::size_t threads = std::max(std::thread::hardware_concurrency(), 1U);
+    return std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(max_queue_size, 1));
+}
+
+sharded_span_processor::sharded_span_processor(
+    std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>> exporters,
+    const batching_options_t& options, std::shared_ptr<export_scheduler> scheduler
+)
+    : m_batcher(
+          is_byte_limited(options) ? make_sized_exporters(std::move(exporters)) : std::move(exporters), options,
+          "spans", "Sharded span processor queue is full - dropping span.", std::move(scheduler)
+      )
+{
+}
+
+std::unique_ptr<::opentelemetry::sdk::trace::Recordable> sharded_span_processor::MakeRecordable() noexcept
+{
+    return this->m_batcher.exporter().MakeRecordable();
+}
+
+void sharded_span_processor::OnStart(
+    ::opentelemetry::sdk::trace::Recordable&, const ::opentelemetry::trace::SpanContext&
+) noexcept
+{
+}
+
+void sharded_span_processor::OnEnd(std::unique_ptr<::opentelemetry::sdk::trace::Recordable>&& span) noexcept
+{
+    this->m_batcher.add(std::move(span));
+}
+
+bool sharded_span_processor::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_batcher.force_flush(timeout);
+}
+
+bool sharded_span_processor::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_batcher.shutdown(timeout);
+}
+
+sharded_log_record_processor::sharded_log_record_processor(
+    std::vector<std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>> exporters,
+    const batching_options_t& options, std::shared_ptr<export_scheduler> scheduler
+)
+    : m_batcher(
+          is_byte_limited(options) ? make_sized_exporters(std::move(exporters)) : std::move(exporters), options,
+          "log records", "Sharded log record processor queue is full - dropping log record.", std::move(scheduler)
+      )
+{
+}
+
+std::unique_ptr<::opentelemetry::sdk::logs::Recordable> sharded_log_record_processor::MakeRecordable() noexcept
+{
+    return this->m_batcher.exporter().MakeRecordable();
+}
+
+void sharded_log_record_processor::OnEmit(std::unique_ptr<::opentelemetry::sdk::logs::Recordable>&& record) noexcept
+{
+    this->m_batcher.add(std::move(record));
+}
+
+bool sharded_log_record_processor::ForceFlush(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_batcher.force_flush(timeout);
+}
+
+bool sharded_log_record_processor::Shutdown(std::chrono::microseconds timeout) noexcept
+{
+    return this->m_batcher.shutdown(timeout);
+}
+
+}  // namespace wwa::opentelemetry
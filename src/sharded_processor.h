@@ -0,0 +1,302 @@
+#ifndef B4E9D2C7_6A1F_4E83_9D5B_7F2C0A8E3B16
+#define B4E9D2C7_6A1F_4E83_9D5B_7F2C0A8E3B16
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <opentelemetry/sdk/logs/exporter.h>
+#include <opentelemetry/sdk/logs/processor.h>
+#include <opentelemetry/sdk/logs/recordable.h>
+#include <opentelemetry/sdk/trace/exporter.h>
+#include <opentelemetry/sdk/trace/processor.h>
+#include <opentelemetry/sdk/trace/recordable.h>
+
+#include "batching.h"
+#include "bounded_queue.h"
+#include "export_dispatcher.h"
+#include "export_scheduler.h"
+#include "fanout_exporter.h"
+#include "queue_stats.h"
+
+namespace wwa::opentelemetry {
+
+std::size_t get_shard_count(std::size_t max_queue_size) noexcept;
+
+/**
+ * Batching queue split into shards, one per hardware thread. Threads are spread over the shards round-robin,
+ * so that threads adding items mostly lock a mutex (and touch a buffer) that no other thread uses;
+ * a single worker (a thread, or a task on the shared export scheduler) swaps the buffers out and exports
+ * their contents in batches.
+ *
+ * `max_queue_size` is the total capacity of all shards; an item that does not fit in its shard is dropped.
+ * `max_queue_bytes` limits all shards together, so that an item larger than a shard's share of it still fits;
+ * a shard only uses its share to start an export cycle early.
+ *
+ * On the shared scheduler, an export cycle that finds no free export slot stops where it is, and resumes once
+ * a slot is free; a shard is only swapped out again when its previous contents have all been handed over.
+ */
+template<typename Recordable, typename Exporter>
+class sharded_batcher {
+public:
+    // `exporters`: instances of the same exporter, one per export slot
+    sharded_batcher(
+        std::vector<std::unique_ptr<Exporter>> exporters, const batching_options_t& options, const char* items,
+        const char* drop_message, std::shared_ptr<export_scheduler> scheduler
+    )
+        : m_options(options), m_drop_message(drop_message), m_shards(get_shard_count(options.max_queue_size)),
+          m_drained(m_shards.size()),
+          m_dispatcher(std::move(exporters), options, items, [this]() { this->m_worker.notify(); }),
+          m_worker(
+              options.schedule_delay, [this](bool block) { return this->export_shards(block); }, std::move(scheduler)
+          )
+    {
+        this->m_options.max_export_batch_size = std::max<std::size_t>(this->m_options.max_export_batch_size, 1);
+
+        const auto count = this->m_shards.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            auto& shard    = this->m_shards[i];
+            shard.capacity = options.max_queue_size / count + (i < options.max_queue_size % count ? 1 : 0);
+            shard.byte_share = options.max_queue_bytes / count;
+
+            shard.items.reserve(shard.capacity);
+            this->m_drained[i].items.reserve(shard.capacity);
+        }
+
+        this->m_batch.reserve(this->m_options.max_export_batch_size);
+        this->m_worker.start();
+    }
+
+    sharded_batcher(const sharded_batcher&)            = delete;
+    sharded_batcher& operator=(const sharded_batcher&) = delete;
+    sharded_batcher(sharded_batcher&&)                 = delete;
+    sharded_batcher& operator=(sharded_batcher&&)      = delete;
+
+    ~sharded_batcher()
+    {
+        if (!this->m_worker.is_stopped()) {
+            this->shutdown(std::chrono::microseconds::max());
+        }
+    }
+
+    Exporter& exporter() noexcept { return this->m_dispatcher.exporter(); }
+
+    void add(std::unique_ptr<Recordable>&& item) noexcept
+    {
+        if (this->m_worker.is_stopped()) {
+            return;
+        }
+
+        std::size_t bytes = 0;
+        bool half_full    = false;
+        if (this->m_options.max_queue_bytes != 0) {
+            // Reserve the bytes first, so that concurrent producers cannot overshoot the limit
+            bytes             = recordable_size(*item);
+            const auto queued = this->m_queued_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            if (queued > this->m_options.max_queue_bytes) {
+                this->m_queued_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+                this->drop();
+                return;
+            }
+
+            half_full = queued >= this->m_options.max_queue_bytes / 2;
+        }
+
+        auto& shard   = this->m_shards[get_thread_slot() % this->m_shards.size()];
+        bool accepted = false;
+        try {
+            const std::lock_guard lock(shard.mutex);
+            if (shard.items.size() < shard.capacity) {
+                // Never reallocates: the buffer has been reserved up to the shard's capacity
+                shard.items.push_back(std::move(item));
+                shard.bytes += bytes;
+                accepted  = true;
+                half_full = half_full || shard.items.size() >= (shard.capacity + 1) / 2 ||
+                            (shard.byte_share != 0 && shard.bytes >= shard.byte_share / 2);
+            }
+        }
+        catch (const std::system_error&) {  // NOLINT(bugprone-empty-catch)
+        }
+
+        if (!accepted) {
+            if (bytes != 0) {
+                this->m_queued_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+            }
+
+            this->drop();
+            return;
+        }
+
+        if (this->m_options.stats) {
+            this->m_options.stats->enqueued.add();
+        }
+
+        // Start an export cycle early once the shard is half full
+        if (half_full) {
+            this->m_worker.notify();
+        }
+    }
+
+    bool force_flush(std::chrono::microseconds timeout) noexcept
+    {
+        return this->m_worker.force_flush(timeout) && this->m_dispatcher.wait(timeout);
+    }
+
+    bool shutdown(std::chrono::microseconds timeout) noexcept
+    {
+        if (!this->m_worker.stop()) {
+            return true;
+        }
+
+        return this->m_dispatcher.shutdown(timeout);
+    }
+
+private:
+    struct alignas(cache_line_size) shard_t {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<Recordable>> items;
+        std::size_t capacity   = 0;
+        std::size_t bytes      = 0;
+        std::size_t byte_share = 0;  // Only starts export cycles early: the byte limit is global
+    };
+
+    // The buffer swapped out of a shard, and the bytes it holds against max_queue_bytes
+    struct drained_t {
+        std::vector<std::unique_ptr<Recordable>> items;
+        std::size_t bytes = 0;
+    };
+
+    batching_options_t m_options;
+    const char* m_drop_message;
+    std::vector<shard_t> m_shards;
+    alignas(cache_line_size) std::atomic<std::size_t> m_queued_bytes{0};  // Only maintained with max_queue_bytes
+
+    // Only used by the export cycle: the buffers swapped out of the shards, and the batch being built (or waiting
+    // for a free export slot)
+    std::vector<drained_t> m_drained;
+    std::vector<std::unique_ptr<Recordable>> m_batch;
+    std::size_t m_batch_bytes = 0;
+
+    // The worker runs the export cycles, the dispatcher exports the batches: stop the worker first
+    export_dispatcher<Recordable, Exporter> m_dispatcher;
+    batch_worker m_worker;
+
+    bool export_shards(bool block)
+    {
+        for (std::size_t i = 0; i < this->m_shards.size(); ++i) {
+            auto& drained = this->m_drained[i];
+            // What is left of a shard whose items found no free export slot in the previous cycle goes first
+            if (drained.items.empty()) {
+                {
+                    // Swapping keeps both buffers' capacity, so that neither side ever allocates
+                    const std::lock_guard lock(this->m_shards[i].mutex);
+                    this->m_shards[i].items.swap(drained.items);
+                    drained.bytes = std::exchange(this->m_shards[i].bytes, 0);
+                }
+
+                if (this->m_options.stats) {
+                    this->m_options.stats->dequeued.fetch_add(drained.items.size(), std::memory_order_relaxed);
+                }
+            }
+
+            std::size_t handed_over = 0;
+            for (auto& item : drained.items) {
+                std::size_t bytes = 0;
+                if (this->m_options.max_export_batch_bytes != 0) {
+                    bytes            = recordable_size(*item);
+                    const auto limit = this->m_options.max_export_batch_bytes;
+                    if (!this->m_batch.empty() && this->m_batch_bytes + bytes > limit && !this->export_batch(block)) {
+                        break;
+                    }
+                }
+
+                if (this->m_batch.size() >= this->m_options.max_export_batch_size && !this->export_batch(block)) {
+                    break;
+                }
+
+                this->m_batch_bytes += bytes;
+                this->m_batch.push_back(std::move(item));
+                ++handed_over;
+            }
+
+            if (handed_over < drained.items.size()) {
+                const auto end = drained.items.begin() + static_cast<std::ptrdiff_t>(handed_over);
+                drained.items.erase(drained.items.begin(), end);
+                return false;
+            }
+
+            drained.items.clear();
+            if (drained.bytes != 0) {
+                this->m_queued_bytes.fetch_sub(std::exchange(drained.bytes, 0), std::memory_order_relaxed);
+            }
+        }
+
+        return this->m_batch.empty() || this->export_batch(block);
+    }
+
+    void drop() noexcept
+    {
+        if (this->m_options.stats) {
+            this->m_options.stats->dropped.add();
+        }
+
+        log_batching_warning(this->m_drop_message);
+    }
+
+    bool export_batch(bool block)
+    {
+        if (!this->m_dispatcher.submit(this->m_batch, block)) {
+            return false;
+        }
+
+        this->m_batch_bytes = 0;
+        return true;
+    }
+};
+
+class sharded_span_processor : public ::opentelemetry::sdk::trace::SpanProcessor {
+public:
+    // `exporters`: instances of the same exporter, one per export slot
+    sharded_span_processor(
+        std::vector<std::unique_ptr<::opentelemetry::sdk::trace::SpanExporter>> exporters,
+        const batching_options_t& options, std::shared_ptr<export_scheduler> scheduler = nullptr
+    );
+
+    std::unique_ptr<::opentelemetry::sdk::trace::Recordable> MakeRecordable() noexcept override;
+    void OnStart(
+        ::opentelemetry::sdk::trace::Recordable& span, const ::opentelemetry::trace::SpanContext& parent_context
+    ) noexcept override;
+    void OnEnd(std::unique_ptr<::opentelemetry::sdk::trace::Recordable>&& span) noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+private:
+    sharded_batcher<::opentelemetry::sdk::trace::Recordable, ::opentelemetry::sdk::trace::SpanExporter> m_batcher;
+};
+
+class sharded_log_record_processor : public ::opentelemetry::sdk::logs::LogRecordProcessor {
+public:
+    // `exporters`: instances of the same exporter, one per export slot
+    sharded_log_record_processor(
+        std::vector<std::unique_ptr<::opentelemetry::sdk::logs::LogRecordExporter>> exporters,
+        const batching_options_t& options, std::shared_ptr<export_scheduler> scheduler = nullptr
+    );
+
+    std::unique_ptr<::opentelemetry::sdk::logs::Recordable> MakeRecordable() noexcept override;
+    void OnEmit(std::unique_ptr<::opentelemetry::sdk::logs::Recordable>&& record) noexcept override;
+    bool ForceFlush(std::chrono::microseconds timeout) noexcept override;
+    bool Shutdown(std::chrono::microseconds timeout) noexcept override;
+
+private:
+    sharded_batcher<::opentelemetry::sdk::logs::Recordable, ::opentelemetry::sdk::logs::LogRecordExporter> m_batcher;
+};
+
+}  // namespace wwa::opentelemetry
+
+#endif /* B4E9D2C7_6A1F_4E83_9D5B_7F2C0A8E3B16 */
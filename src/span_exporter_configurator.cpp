@@ -1,5 +1,5 @@
-#include <algorithm>
 #include <format>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -14,17 +14,15 @@
 #endif
 
 #include "configurator_p.h"
-#include "helpers.h"
+#include "instrumented_exporter.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace {
 
-wwa::opentelemetry::span_exporter_t configure_otlp()
+wwa::opentelemetry::span_exporter_t configure_otlp(const wwa::opentelemetry::environment_t& env)
 {
-    using wwa::opentelemetry::helpers::get_otlp_protocol;
-
-    const auto protocol =
-        get_otlp_protocol("OTEL_EXPORTER_OTLP_TRACES_PROTOCOL", "OTEL_EXPORTER_OTLP_PROTOCOL", "http/protobuf");
+    const auto& protocol = env.traces_protocol;
 
 #if !defined(OTEL_SPAN_EXPORTER_OTLP_GRPC_DISABLED)
     if (protocol == "grpc") {
@@ -46,10 +44,13 @@ wwa::opentelemetry::span_exporter_t configure_otlp()
 }
 
 wwa::opentelemetry::span_exporter_t
-get_span_exporter(std::string_view name, wwa::opentelemetry::span_exporter_factory_t factory)
+get_span_exporter(
+    std::string_view name, wwa::opentelemetry::span_exporter_factory_t factory,
+    const wwa::opentelemetry::environment_t& env
+)
 {
     if (name == "otlp") {
-        return configure_otlp();
+        return configure_otlp(env);
     }
 
     return factory != nullptr ? factory(name) : nullptr;
@@ -61,30 +62,24 @@ namespace wwa::opentelemetry {
 
 std::vector<span_exporter_t> configure_span_exporters_from_environment(const span_exporter_config_t& opts)
 {
-    const auto exporters_env = helpers::get_env("OTEL_TRACES_EXPORTER");
-    auto names               = helpers::split_and_trim(exporters_env);
-
-    if (names.size() == 1 && names[0] == "none") {
-        INTERNAL_LOG_WARN("OTEL_TRACES_EXPORTER contains \"none\". Tracing will not be initialized.");
-        return {};
-    }
-
-    if (names.empty()) {
-        INTERNAL_LOG_WARN("OTEL_TRACES_EXPORTER is empty. Using default otlp exporter.");
-        names = {"otlp"};
-    }
-    else if (std::ranges::find(names, "none") != names.end()) {
-        INTERNAL_LOG_WARN(
-            "OTEL_TRACES_EXPORTER contains \"none\" along with other exporters. Using default otlp exporter."
-        );
+    return configure_span_exporters_from_environment(opts, *get_process_environment(environment_scope_t::traces));
+}
 
-        names = {"otlp"};
-    }
+std::vector<span_exporter_t>
+configure_span_exporters_from_environment(const span_exporter_config_t& opts, const environment_t& env)
+{
+    const auto& names = env.traces_exporters;
 
     std::vector<wwa::opentelemetry::span_exporter_t> exporters;
     exporters.reserve(names.size());
     for (const auto& name : names) {
-        if (auto exporter = get_span_exporter(name, opts.factory); exporter) {
+        if (auto exporter = get_span_exporter(name, opts.factory, env); exporter) {
+            if (env.self_telemetry) {
+                exporter = std::make_unique<instrumented_span_exporter>(
+                    std::move(exporter), make_exporter_telemetry("traces", name)
+                );
+            }
+
             exporters.push_back(std::move(exporter));
         }
         else {
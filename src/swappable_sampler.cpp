@@ -0,0 +1,199 @@
+#include "opentelemetry/configurator/wwa/swappable_sampler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <format>
+#include <thread>
+#include <utility>
+
+#include <opentelemetry/sdk/trace/samplers/parent_factory.h>
+#include <opentelemetry/sdk/trace/samplers/trace_id_ratio_factory.h>
+
+#include "batching.h"
+#include "bounded_queue.h"
+#include "configurator_p.h"
+#include "export_scheduler.h"
+#include "queue_stats.h"
+
+namespace {
+
+static_assert(std::atomic<bool>::is_always_lock_free, "request_reload() must be async-signal-safe");
+
+constexpr std::chrono::milliseconds reload_poll_interval{1000};
+
+}  // namespace
+
+namespace wwa::opentelemetry {
+
+/**
+ * Two sets of counters of the ShouldSample() calls in flight, split by thread so that the calls do not fight over
+ * a cache line. A call registers in the set of the current epoch; a swap flips the epoch and waits for the other
+ * set to drain, twice, so that a call which read a stale epoch is waited for as well.
+ */
+struct swappable_sampler::readers_t {
+    static constexpr std::size_t cell_count = 16;
+
+    struct alignas(cache_line_size) cell_t {
+        std::atomic<std::uint64_t> count{0};
+    };
+
+    std::atomic<std::uint64_t> epoch{0};
+    std::array<std::array<cell_t, cell_count>, 2> cells{};
+};
+
+swappable_sampler::swappable_sampler(tracing_sampler_config_t opts)
+    : m_readers(std::make_unique<readers_t>()), m_config(opts)
+{
+    this->install(*get_process_environment(environment_scope_t::traces));
+    this->schedule_reloads();
+}
+
+swappable_sampler::swappable_sampler(tracing_sampler_t delegate, tracing_sampler_config_t opts)
+    : m_readers(std::make_unique<readers_t>()), m_config(opts)
+{
+    if (delegate) {
+        this->swap(std::move(delegate));
+    }
+    else {
+        this->install(*get_process_environment(environment_scope_t::traces));
+    }
+
+    this->schedule_reloads();
+}
+
+swappable_sampler::~swappable_sampler()
+{
+    if (this->m_scheduler) {
+        this->m_scheduler->cancel(this->m_reload_task);
+    }
+}
+
+::opentelemetry::sdk::trace::SamplingResult swappable_sampler::ShouldSample(
+    const ::opentelemetry::trace::SpanContext& parent_context, ::opentelemetry::trace::TraceId trace_id,
+    ::opentelemetry::nostd::string_view name, ::opentelemetry::trace::SpanKind span_kind,
+    const ::opentelemetry::common::KeyValueIterable& attributes,
+    const ::opentelemetry::trace::SpanContextKeyValueIterable& links
+) noexcept
+{
+    // Sequentially consistent: the swap must either see the call registered, or the call must see the new delegate
+    auto& readers = *this->m_readers;
+    auto& cell    = readers.cells[readers.epoch.load() & 1U][get_thread_slot() % readers_t::cell_count];
+    cell.count.fetch_add(1);
+    auto result = this->m_delegate.load()->ShouldSample(parent_context, trace_id, name, span_kind, attributes, links);
+    cell.count.fetch_sub(1, std::memory_order_release);
+    return result;
+}
+
+::opentelemetry::nostd::string_view swappable_sampler::GetDescription() const noexcept
+{
+    // The delegate's description would not outlive a swap
+    return "SwappableSampler";
+}
+
+void swappable_sampler::swap(tracing_sampler_t delegate)
+{
+    if (!delegate) {
+        INTERNAL_LOG_WARN("Refusing to install a null tracing sampler");
+        return;
+    }
+
+    const std::lock_guard lock(this->m_mutex);
+    this->m_delegate.store(delegate.get());
+    std::swap(this->m_current, delegate);
+
+    // `delegate` now holds the replaced sampler: destroy it once nobody can be using it
+    this->wait_for_readers();
+}
+
+void swappable_sampler::set_ratio(double ratio)
+{
+    using namespace ::opentelemetry::sdk::trace;
+
+    ratio = std::isnan(ratio) ? 0.0 : std::clamp(ratio, 0.0, 1.0);
+    this->swap(ParentBasedSamplerFactory::Create(TraceIdRatioBasedSamplerFactory::Create(ratio)));
+}
+
+void swappable_sampler::reload(const environment_t& env)
+{
+    // The span processors only keep the queue counters the adaptive sampler needs when built for it
+    const auto has_span_queue_stats = []() {
+        return std::ranges::any_of(get_queue_stats(), [](const auto& stats) { return stats->signal == "traces"; });
+    };
+
+    if (env.traces_sampler == "adaptive" && !has_span_queue_stats()) {
+        INTERNAL_LOG_WARN(
+            "Cannot switch to the adaptive sampler: the span processors were not built for it, keeping the current "
+            "sampler"
+        );
+        return;
+    }
+
+    this->install(env);
+}
+
+void swappable_sampler::install(const environment_t& env)
+{
+    this->swap(configure_tracing_sampler_from_environment(tracing_sampler_config_t{this->m_config}, env));
+}
+
+void swappable_sampler::reload()
+{
+    const auto env = capture_sampler_environment();
+    report_environment_warnings(env);
+    this->reload(env);
+}
+
+void swappable_sampler::request_reload() noexcept
+{
+    this->m_reload_requested.store(true, std::memory_order_release);
+}
+
+void swappable_sampler::wait_for_readers() noexcept
+{
+    auto& readers = *this->m_readers;
+    for (int phase = 0; phase < 2; ++phase) {
+        const auto previous = readers.epoch.fetch_add(1) & 1U;
+        for (const auto& cell : readers.cells[previous]) {
+            while (cell.count.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+        }
+    }
+}
+
+bool swappable_sampler::reload_if_requested()
+{
+    if (!this->m_reload_requested.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+
+    this->reload();
+    return true;
+}
+
+void swappable_sampler::schedule_reloads()
+{
+    // A signal handler cannot wake a thread portably: poll the flag set by request_reload(), on the shared
+    // scheduler only, so that the sampler never needs a thread of its own
+    this->m_scheduler = get_export_scheduler(*get_process_environment());
+    if (this->m_scheduler) {
+        this->m_reload_task = this->m_scheduler->schedule(
+            [this]() {
+                try {
+                    this->reload_if_requested();
+                }
+                catch (const std::exception& e) {
+                    INTERNAL_LOG_WARN(std::format("Failed to reload the tracing sampler: {}", e.what()));
+                }
+            },
+            reload_poll_interval
+        );
+    }
+}
+
+}  // namespace wwa::opentelemetry
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <utility>
 #include <variant>
@@ -9,21 +11,38 @@
 #include <opentelemetry/sdk/trace/tracer_provider_factory.h>
 
 #include "configurator_p.h"
+#include "fanout_exporter.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
 
 namespace wwa::opentelemetry {
 
 tracer_provider_t configure_tracer_provider(tracer_provider_config_t&& opts)
 {
-    std::vector<span_exporter_t> exporters;
-    if (opts.configure_exporters) {
-        exporters = configure_span_exporters_from_environment(opts.span_exporter_config);
+    return configure_tracer_provider(std::move(opts), *get_process_environment(environment_scope_t::traces));
+}
+
+tracer_provider_t configure_tracer_provider(tracer_provider_config_t&& opts, const environment_t& env)
+{
+    // Every export slot of a processor gets instances of its own, so that the exports can run concurrently
+    std::vector<std::vector<span_exporter_t>> instances;
+    const auto copies = opts.configure_exporters ? std::max<std::size_t>(env.bsp.max_concurrent_exports, 1) : 0;
+    for (std::size_t i = 0; i < copies; ++i) {
+        auto exporters = configure_span_exporters_from_environment(opts.span_exporter_config, env);
+        if (env.bsp.fanout && exporters.size() > 1) {
+            // One queue for all exporters instead of a processor (and a queue) per exporter
+            span_exporter_t fanout = std::make_unique<fanout_span_exporter>(std::move(exporters));
+            exporters.clear();
+            exporters.push_back(std::move(fanout));
+        }
+
+        add_exporter_instances(instances, std::move(exporters));
     }
 
     std::vector<span_processor_t> processors;
-    processors.reserve(exporters.size() + opts.processors.size());
-    for (auto&& exporter : exporters) {
-        processors.push_back(get_batch_span_processor(std::move(exporter)));
+    processors.reserve(instances.size() + opts.processors.size());
+    for (auto&& exporters : instances) {
+        processors.push_back(get_batch_span_processor(std::move(exporters), env));
     }
 
     for (auto&& processor : opts.processors) {
@@ -37,11 +56,11 @@ tracer_provider_t configure_tracer_provider(tracer_provider_config_t&& opts)
     auto sampler = std::holds_alternative<tracing_sampler_config_t>(opts.tracing_sampler)
                        ? configure_tracing_sampler_from_environment(
                              // NOLINTNEXTLINE(performance-move-const-arg)
-                             std::move(std::get<tracing_sampler_config_t>(opts.tracing_sampler))
+                             std::move(std::get<tracing_sampler_config_t>(opts.tracing_sampler)), env
                          )
                        : std::move(std::get<tracing_sampler_t>(opts.tracing_sampler));
 
-    auto id_generator = opts.id_generator ? std::move(opts.id_generator) : get_id_generator();
+    auto id_generator = opts.id_generator ? std::move(opts.id_generator) : get_id_generator(env);
 
     return ::opentelemetry::sdk::trace::TracerProviderFactory::Create(
         std::move(processors), resource, std::move(sampler), std::move(id_generator)
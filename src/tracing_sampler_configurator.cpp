@@ -11,46 +11,78 @@
 #include <opentelemetry/sdk/trace/samplers/parent_factory.h>
 #include <opentelemetry/sdk/trace/samplers/trace_id_ratio_factory.h>
 
+#include "adaptive_sampler.h"
 #include "configurator_p.h"
-#include "helpers.h"
 #include "opentelemetry/configurator/wwa/configurator.h"
+#include "opentelemetry/configurator/wwa/environment.h"
+#include "rate_limiting_sampler.h"
 
 namespace {
 
 using namespace std::literals;
 using namespace opentelemetry::sdk::trace;
-using sampler_creator_t = wwa::opentelemetry::tracing_sampler_t (*)();
+using sampler_creator_t = wwa::opentelemetry::tracing_sampler_t (*)(const wwa::opentelemetry::environment_t&);
 
-auto create_traceidratio_sampler()
+wwa::opentelemetry::tracing_sampler_t create_alwayson_sampler(const wwa::opentelemetry::environment_t&)
 {
-    using wwa::opentelemetry::helpers::get_env_double;
+    return AlwaysOnSamplerFactory::Create();
+}
 
-    const auto ratio = get_env_double("OTEL_TRACES_SAMPLER_ARG", 1.0, 0.0, 1.0);
-    return TraceIdRatioBasedSamplerFactory::Create(ratio);
+wwa::opentelemetry::tracing_sampler_t create_alwaysoff_sampler(const wwa::opentelemetry::environment_t&)
+{
+    return AlwaysOffSamplerFactory::Create();
+}
+
+wwa::opentelemetry::tracing_sampler_t create_traceidratio_sampler(const wwa::opentelemetry::environment_t& env)
+{
+    return TraceIdRatioBasedSamplerFactory::Create(env.traces_sampler_arg.value_or(1.0));
 }
 
-auto create_parentbased_alwayson_sampler()
+wwa::opentelemetry::tracing_sampler_t create_parentbased_alwayson_sampler(const wwa::opentelemetry::environment_t&)
 {
     return ParentBasedSamplerFactory::Create(AlwaysOnSamplerFactory::Create());
 }
 
-auto create_parentbased_alwaysoff_sampler()
+wwa::opentelemetry::tracing_sampler_t create_parentbased_alwaysoff_sampler(const wwa::opentelemetry::environment_t&)
 {
     return ParentBasedSamplerFactory::Create(AlwaysOffSamplerFactory::Create());
 }
 
-auto create_parentbased_traceidratio_sampler()
+wwa::opentelemetry::tracing_sampler_t
+create_parentbased_traceidratio_sampler(const wwa::opentelemetry::environment_t& env)
 {
-    return ParentBasedSamplerFactory::Create(create_traceidratio_sampler());
+    return ParentBasedSamplerFactory::Create(create_traceidratio_sampler(env));
 }
 
-constexpr std::array<std::pair<std::string_view, sampler_creator_t>, 6> samplers{
-    {{"always_on"sv, &AlwaysOnSamplerFactory::Create},
-     {"always_off"sv, &AlwaysOffSamplerFactory::Create},
+wwa::opentelemetry::tracing_sampler_t create_ratelimiting_sampler(const wwa::opentelemetry::environment_t& env)
+{
+    const auto rate = env.traces_sampler_arg.value_or(wwa::opentelemetry::default_ratelimiting_rate);
+    return std::make_unique<wwa::opentelemetry::rate_limiting_sampler>(rate);
+}
+
+wwa::opentelemetry::tracing_sampler_t
+create_parentbased_ratelimiting_sampler(const wwa::opentelemetry::environment_t& env)
+{
+    return ParentBasedSamplerFactory::Create(create_ratelimiting_sampler(env));
+}
+
+wwa::opentelemetry::tracing_sampler_t create_adaptive_sampler(const wwa::opentelemetry::environment_t& env)
+{
+    // Child spans follow the decision made for the root, so that whole traces are kept or shed
+    const auto target = env.traces_sampler_arg.value_or(wwa::opentelemetry::default_adaptive_target);
+    return ParentBasedSamplerFactory::Create(std::make_shared<wwa::opentelemetry::adaptive_sampler>(target));
+}
+
+constexpr std::array<std::pair<std::string_view, sampler_creator_t>, 9> samplers{
+    {{"always_on"sv, &create_alwayson_sampler},
+     {"always_off"sv, &create_alwaysoff_sampler},
      {"traceidratio"sv, &create_traceidratio_sampler},
      {"parentbased_always_on"sv, &create_parentbased_alwayson_sampler},
      {"parentbased_always_off"sv, &create_parentbased_alwaysoff_sampler},
-     {"parentbased_traceidratio"sv, &create_parentbased_traceidratio_sampler}}
+     {"parentbased_traceidratio"sv, &create_parentbased_traceidratio_sampler},
+     {"ratelimiting"sv, &create_ratelimiting_sampler},
+     {"parentbased_ratelimiting"sv, &create_parentbased_ratelimiting_sampler},
+     {"adaptive"sv, &create_adaptive_sampler}}
 };
 
 wwa::opentelemetry::tracing_sampler_t default_factory_impl(std::string_view)
@@ -62,15 +94,22 @@ wwa::opentelemetry::tracing_sampler_t default_factory_impl(std::string_view)
 
 namespace wwa::opentelemetry {
 
-// NOLINTNEXTLINE(cppcoreguidelines-rvalue-reference-param-not-moved)
 tracing_sampler_t configure_tracing_sampler_from_environment(tracing_sampler_config_t&& opts)
+{
+    return configure_tracing_sampler_from_environment(
+        std::move(opts), *get_process_environment(environment_scope_t::traces)  // NOLINT(performance-move-const-arg)
+    );
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-rvalue-reference-param-not-moved)
+tracing_sampler_t configure_tracing_sampler_from_environment(tracing_sampler_config_t&& opts, const environment_t& env)
 {
     auto factory = opts.factory != nullptr ? opts.factory : default_factory_impl;
 
-    if (const auto name = helpers::get_env("OTEL_TRACES_SAMPLER"); !name.empty()) {
+    if (const auto& name = env.traces_sampler; !name.empty()) {
         for (const auto& [key, value] : samplers) {
             if (name == key) {
-                return value();
+                return value(env);
             }
 
             if (auto sampler = factory(name); sampler) {
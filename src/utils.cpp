@@ -1,11 +1,15 @@
 #include "opentelemetry/configurator/wwa/utils.h"
 
+#include <atomic>
 #include <cassert>
+#include <cstdint>
 #include <string>
 #include <typeinfo>
 
 #include <opentelemetry/common/attribute_value.h>
 #include <opentelemetry/nostd/string_view.h>
+#include <opentelemetry/trace/default_span.h>
+#include <opentelemetry/trace/span_context.h>
 
 #if OPENTELEMETRY_VERSION_MAJOR == 1 && OPENTELEMETRY_VERSION_MINOR < 18
 #    include <opentelemetry/sdk/resource/semantic_conventions.h>
@@ -15,6 +19,12 @@
 
 namespace {
 
+std::atomic<std::uint64_t>& provider_generation() noexcept
+{
+    static std::atomic<std::uint64_t> generation{0};
+    return generation;
+}
+
 std::string get_exception_type(const std::exception* e)
 {
     return typeid(*e).name();
@@ -24,6 +34,16 @@ std::string get_exception_type(const std::exception* e)
 
 namespace wwa::opentelemetry {
 
+std::atomic<bool> tracing_enabled{true};
+
+const span_t& get_noop_span() noexcept
+{
+    static const span_t span(
+        new ::opentelemetry::trace::DefaultSpan(::opentelemetry::trace::SpanContext::GetInvalid())
+    );
+    return span;
+}
+
 void record_exception(const span_t& span, const std::exception* e)
 {
 #if OPENTELEMETRY_VERSION_MAJOR == 1 && OPENTELEMETRY_VERSION_MINOR < 18
@@ -44,4 +64,14 @@ void record_exception(const span_t& span, const std::exception* e)
     span->AddEvent("exception", attrs);
 }
 
+const std::atomic<std::uint64_t>& get_provider_generation() noexcept
+{
+    return provider_generation();
+}
+
+void invalidate_cached_handles() noexcept
+{
+    provider_generation().fetch_add(1, std::memory_order_release);
+}
+
 }  // namespace wwa::opentelemetry